@@ -0,0 +1,119 @@
+/*
+ * main.c - Headless host harness for RPMegaFighter
+ *
+ * Runs the unmodified game main() against the emulated RIA in ria_host.c
+ * for a fixed number of virtual frames (or until the game exits, e.g. at
+ * the end of an INPUT_PLAYBACK replay), then reports throughput.
+ *
+ * Usage: rpmegafighter_host [--frames N] [--quiet]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdint.h>
+#include "xram_stats.h"
+
+extern unsigned long ria_host_frames;
+extern unsigned long ria_host_port_accesses;
+extern void (*ria_host_frame_hook)(void);
+
+#ifdef XRAM_STATS
+extern unsigned long ria_host_xram_frames;
+extern unsigned long ria_host_xram_total[XS_COUNT][XSK_COUNT];
+extern unsigned ria_host_xram_max[XS_COUNT][XSK_COUNT];
+#endif
+
+// Game entry point (rpmegafighter.c main, renamed for the host build)
+int rpmegafighter_main(void);
+
+static unsigned long frame_limit = 60UL * 60 * 10;  // 10 minutes at 60 Hz
+static struct timespec start_time;
+
+static double elapsed_seconds(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)(now.tv_sec - start_time.tv_sec) +
+           (double)(now.tv_nsec - start_time.tv_nsec) / 1e9;
+}
+
+// Printed on any exit: the frame limit, a finished replay or ESC
+static void report(void)
+{
+    if (ria_host_frames == 0) {
+        return;
+    }
+
+    double secs = elapsed_seconds();
+    double fps = secs > 0.0 ? ria_host_frames / secs : 0.0;
+
+    fprintf(stderr, "frames:        %lu\n", ria_host_frames);
+    fprintf(stderr, "seconds:       %.3f\n", secs);
+    fprintf(stderr, "frames/sec:    %.0f (%.1fx realtime)\n", fps, fps / 60.0);
+    fprintf(stderr, "port accesses: %.1f per frame\n",
+            (double)ria_host_port_accesses / ria_host_frames);
+
+#ifdef XRAM_STATS
+    static const char *const names[XS_COUNT] = XRAM_OWNER_NAMES;
+    static const char *const kinds[XSK_COUNT] = { "reads", "writes", "changed" };
+    unsigned long n = ria_host_xram_frames;
+    unsigned long sum[XSK_COUNT] = { 0, 0, 0 };
+
+    if (n == 0) {
+        return;
+    }
+    fprintf(stderr, "\nXRAM port traffic per gameplay frame (%lu frames)\n", n);
+    fprintf(stderr, "  %-11s", "subsystem");
+    for (int k = 0; k < XSK_COUNT; k++) {
+        fprintf(stderr, " %9s %6s", kinds[k], "max");
+    }
+    fprintf(stderr, "\n");
+    for (int o = 0; o < XS_COUNT; o++) {
+        fprintf(stderr, "  %-11s", names[o]);
+        for (int k = 0; k < XSK_COUNT; k++) {
+            fprintf(stderr, " %9.1f %6u",
+                    (double)ria_host_xram_total[o][k] / n, ria_host_xram_max[o][k]);
+            sum[k] += ria_host_xram_total[o][k];
+        }
+        fprintf(stderr, "\n");
+    }
+    fprintf(stderr, "  %-11s", "total");
+    for (int k = 0; k < XSK_COUNT; k++) {
+        fprintf(stderr, " %9.1f %6s", (double)sum[k] / n, "");
+    }
+    fprintf(stderr, "\n");
+#endif
+}
+
+static void on_frame(void)
+{
+    if (ria_host_frames >= frame_limit) {
+        exit(0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frame_limit = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            // Game logging goes to stdout; the report goes to stderr
+            if (!freopen("/dev/null", "w", stdout)) {
+                perror("freopen");
+            }
+        } else {
+            fprintf(stderr, "usage: %s [--frames N] [--quiet]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (frame_limit == 0) frame_limit = 1;
+
+    ria_host_frame_hook = on_frame;
+    atexit(report);
+    timespec_get(&start_time, TIME_UTC);
+
+    return rpmegafighter_main();
+}
@@ -0,0 +1,212 @@
+/*
+ * ria_host.c - Emulated RIA registers and 64 KiB XRAM for the host build
+ *
+ * Each access to RIA.rw0/rw1 lands here through the macros in rp6502.h.
+ * The port cell is preloaded with the XRAM byte at the current address and
+ * written back on the next access, so reads see XRAM and writes reach it.
+ *
+ * VSYNC is virtual: the counter only advances when the game spins on it
+ * (two back-to-back vsync reads with no port traffic in between), so the
+ * gameplay loop runs as fast as the host CPU allows.
+ */
+
+#include <rp6502.h>
+#include "xram_stats.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <unistd.h>
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+struct __RIA ria_host = { .step0 = 1, .step1 = 1 };
+uint8_t ria_host_xram[0x10000];
+
+// Frames elapsed and port accesses issued since startup
+unsigned long ria_host_frames = 0;
+unsigned long ria_host_port_accesses = 0;
+
+// Called after every virtual vsync edge (NULL = none)
+void (*ria_host_frame_hook)(void) = NULL;
+
+static bool pending[2];
+static uint16_t pending_addr[2];
+
+#ifdef XRAM_STATS
+// Port traffic per xram_owner over gameplay frames, indexed by XSK_*: reads,
+// writes and bytes the access changed (a write of a new value). Frames with
+// traffic from XS_OTHER alone (title and level screens) are not counted.
+unsigned long ria_host_xram_frames = 0;
+unsigned long ria_host_xram_total[XS_COUNT][XSK_COUNT];
+unsigned ria_host_xram_max[XS_COUNT][XSK_COUNT];
+
+static unsigned frame_traffic[XS_COUNT][XSK_COUNT];
+static uint8_t pending_owner[2];
+static uint8_t pending_loaded[2];
+
+// XRAM the RIA fills with keyboard and gamepad state, as mapped by xregn().
+// A port access cannot tell a read from a write, so accesses inside these
+// spans count as reads and all others as writes: the game never reads back
+// XRAM it wrote itself.
+#define KEYBOARD_SPAN 32        // 256 key bits
+#define GAMEPAD_SPAN  (4 * 10)  // 4 pads of 10 bytes
+static unsigned input_addr[2] = { 0x10000, 0x10000 };
+static const unsigned input_span[2] = { KEYBOARD_SPAN, GAMEPAD_SPAN };
+
+static bool is_input_read(uint16_t a)
+{
+    for (uint8_t d = 0; d < 2; d++) {
+        if (a >= input_addr[d] && a - input_addr[d] < input_span[d]) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+static uint8_t vsync_count = 0;
+static bool last_access_was_vsync = false;
+static bool last_vsync_advanced = false;
+
+// ============================================================================
+// PORT ACCESS
+// ============================================================================
+
+#ifdef XRAM_STATS
+// Fold the finished frame's traffic into the totals
+static void xram_stats_frame(void)
+{
+    bool gameplay = false;
+    for (uint8_t o = XS_OTHER + 1; o < XS_COUNT; o++) {
+        if (frame_traffic[o][XSK_READ] || frame_traffic[o][XSK_WRITE]) {
+            gameplay = true;
+        }
+    }
+
+    if (gameplay) {
+        ria_host_xram_frames++;
+        for (uint8_t o = 0; o < XS_COUNT; o++) {
+            for (uint8_t k = 0; k < XSK_COUNT; k++) {
+                ria_host_xram_total[o][k] += frame_traffic[o][k];
+                if (frame_traffic[o][k] > ria_host_xram_max[o][k]) {
+                    ria_host_xram_max[o][k] = frame_traffic[o][k];
+                }
+            }
+        }
+    }
+
+    for (uint8_t o = 0; o < XS_COUNT; o++) {
+        for (uint8_t k = 0; k < XSK_COUNT; k++) {
+            frame_traffic[o][k] = 0;
+        }
+    }
+}
+#endif
+
+void ria_host_commit(void)
+{
+    for (uint8_t p = 0; p < 2; p++) {
+        if (pending[p]) {
+        #ifdef XRAM_STATS
+            if (ria_host.rw_[p] != pending_loaded[p]) {
+                frame_traffic[pending_owner[p]][XSK_CHANGED]++;
+            }
+        #endif
+            ria_host_xram[pending_addr[p]] = ria_host.rw_[p];
+            pending[p] = false;
+        }
+    }
+}
+
+unsigned char ria_host_rw(uint8_t port)
+{
+    ria_host_commit();
+    last_access_was_vsync = false;
+
+    unsigned *addr = port ? &ria_host.addr1 : &ria_host.addr0;
+    signed char step = port ? ria_host.step1 : ria_host.step0;
+    uint16_t a = *addr & 0xFFFF;
+
+    ria_host.rw_[port] = ria_host_xram[a];
+    pending[port] = true;
+    pending_addr[port] = a;
+    *addr = (uint16_t)(a + step);
+
+    ria_host_port_accesses++;
+#ifdef XRAM_STATS
+    uint8_t owner = xram_owner < XS_COUNT ? xram_owner : XS_OTHER;
+    pending_owner[port] = owner;
+    pending_loaded[port] = ria_host.rw_[port];
+    frame_traffic[owner][is_input_read(a) ? XSK_READ : XSK_WRITE]++;
+#endif
+    return port;
+}
+
+unsigned char ria_host_vsync(void)
+{
+    ria_host_commit();
+
+    // A second consecutive poll means the game is waiting: start a new frame
+    if (last_access_was_vsync && !last_vsync_advanced) {
+        vsync_count++;
+        ria_host_frames++;
+        last_vsync_advanced = true;
+    #ifdef XRAM_STATS
+        xram_stats_frame();
+    #endif
+        if (ria_host_frame_hook) {
+            ria_host_frame_hook();
+        }
+    } else {
+        last_vsync_advanced = false;
+    }
+    last_access_was_vsync = true;
+
+    ria_host.vsync_[0] = vsync_count;
+    return 0;
+}
+
+// ============================================================================
+// XREG / XRAM HELPERS
+// ============================================================================
+
+int xregn(char device, char channel, unsigned char address, unsigned count, ...)
+{
+#ifdef XRAM_STATS
+    // RIA registers 0 and 2 map the keyboard and gamepads into XRAM
+    if (device == 0 && channel == 0 && (address == 0 || address == 2) && count == 1) {
+        va_list args;
+        va_start(args, count);
+        input_addr[address / 2] = va_arg(args, unsigned);
+        va_end(args);
+    }
+#else
+    (void)device;
+    (void)channel;
+    (void)address;
+    (void)count;
+#endif
+    return 0;
+}
+
+int read_xram(unsigned buf, unsigned count, int fildes)
+{
+    uint8_t chunk[256];
+    int total = 0;
+
+    ria_host_commit();
+    while (count > 0) {
+        unsigned want = count < sizeof(chunk) ? count : sizeof(chunk);
+        ssize_t got = read(fildes, chunk, want);
+        if (got < 0) return total ? total : -1;
+        if (got == 0) break;
+        for (ssize_t i = 0; i < got; i++) {
+            ria_host_xram[(uint16_t)(buf + total + i)] = chunk[i];
+        }
+        total += got;
+        count -= got;
+    }
+    return total;
+}
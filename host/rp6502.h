@@ -0,0 +1,123 @@
+/*
+ * rp6502.h - Host stand-in for the llvm-mos RP6502 platform header
+ *
+ * Only used by the ENABLE_HOST_BUILD target. It provides the subset of the
+ * RIA register file, VGA config structs and xreg/xram helpers the game uses,
+ * backed by a 64 KiB XRAM array in ria_host.c.
+ *
+ * The RIA data ports have side effects on every access (the address register
+ * advances by the step), which plain C struct members cannot express. The
+ * rw0/rw1/vsync members are therefore macros that route each access through
+ * a hook: the hook commits the previous access to XRAM, loads the current
+ * XRAM byte into the port cell and steps the address. Game code still reads
+ * and writes `RIA.rw0` exactly as it does on hardware.
+ */
+
+#ifndef RP6502_HOST_H
+#define RP6502_HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// RIA REGISTERS
+// ============================================================================
+
+struct __RIA {
+    unsigned char vsync_[1];
+    unsigned char rw_[2];
+    signed char step0;
+    unsigned addr0;
+    signed char step1;
+    unsigned addr1;
+};
+
+extern struct __RIA ria_host;
+
+unsigned char ria_host_rw(uint8_t port);
+unsigned char ria_host_vsync(void);
+
+#define RIA   ria_host
+#define rw0   rw_[ria_host_rw(0)]
+#define rw1   rw_[ria_host_rw(1)]
+#define vsync vsync_[ria_host_vsync()]
+
+// ============================================================================
+// XRAM / XREG
+// ============================================================================
+
+int xregn(char device, char channel, unsigned char address, unsigned count, ...);
+int read_xram(unsigned buf, unsigned count, int fildes);
+
+// Same register sequence as the platform macro, so step0 is left in the
+// state the game code expects afterwards.
+#define xram0_struct_set(addr, type, member, val)                  \
+    RIA.addr0 = (unsigned)offsetof(type, member) + (unsigned)(addr); \
+    switch (sizeof(((type *)0)->member))                           \
+    {                                                              \
+    case 1:                                                        \
+        RIA.rw0 = (uint8_t)(val);                                  \
+        break;                                                     \
+    case 2:                                                        \
+        RIA.step0 = 1;                                             \
+        RIA.rw0 = (val) & 0xff;                                    \
+        RIA.rw0 = ((val) >> 8) & 0xff;                             \
+        break;                                                     \
+    }
+
+// ============================================================================
+// VGA CONFIG STRUCTS
+// ============================================================================
+
+typedef struct {
+    bool x_wrap;
+    bool y_wrap;
+    int16_t x_pos_px;
+    int16_t y_pos_px;
+    int16_t width_chars;
+    int16_t height_chars;
+    uint16_t xram_data_ptr;
+    uint16_t xram_palette_ptr;
+    uint16_t xram_font_ptr;
+} vga_mode1_config_t;
+
+typedef struct {
+    bool x_wrap;
+    bool y_wrap;
+    int16_t x_pos_px;
+    int16_t y_pos_px;
+    int16_t width_px;
+    int16_t height_px;
+    uint16_t xram_data_ptr;
+    uint16_t xram_palette_ptr;
+} vga_mode3_config_t;
+
+typedef struct {
+    int16_t x_pos_px;
+    int16_t y_pos_px;
+    uint16_t xram_sprite_ptr;
+    uint8_t log_size;
+    bool has_opacity_metadata;
+} vga_mode4_sprite_t;
+
+typedef struct {
+    int16_t transform[6];
+    int16_t x_pos_px;
+    int16_t y_pos_px;
+    uint16_t xram_sprite_ptr;
+    uint8_t log_size;
+    bool has_opacity_metadata;
+} vga_mode4_asprite_t;
+
+// ============================================================================
+// HOST HARNESS
+// ============================================================================
+
+// Emulated XRAM, exposed so the harness can inspect or seed it
+extern uint8_t ria_host_xram[0x10000];
+
+// Flush the pending port access into XRAM
+void ria_host_commit(void);
+
+#endif // RP6502_HOST_H
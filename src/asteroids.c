@@ -9,34 +9,45 @@
 #include <stdlib.h>
 #include "explosions.h"    // Needs start_explosion()   
 #include "text.h"           // For score display update
+#include "sprite_shadow.h"
+#include "trig_tables.h"
+#include "collision.h"
+#include "pool.h"
 
-// Rotation Tables (Reuse from player.c)
-extern const int16_t sin_fix[];
-extern const int16_t cos_fix[];
 
-const int16_t t2_fix32[] = {
-       0, 1152, 2560, 4064, 5536, 6944, 8128, 9056, 9632, 9856, 
-    9632, 9056, 8128, 6944, 5536, 4064, 2560, 1152,    0, -928, 
-   -1504, -1728, -1504, -928,    0
-};
+// All three sizes share one set of arrays, one array per field: Large
+// rocks first, then Medium, then Small. Slot i of a size is entry
+// ast_first[type] + i.
+#define MAX_ASTEROIDS (MAX_AST_L + MAX_AST_M + MAX_AST_S)
 
-#define MAX_ROTATION 24
+static int16_t ast_x[MAX_ASTEROIDS];        // World position
+static int16_t ast_y[MAX_ASTEROIDS];
+static int16_t ast_rx[MAX_ASTEROIDS];       // Sub-pixel remainders
+static int16_t ast_ry[MAX_ASTEROIDS];
+static int16_t ast_vx[MAX_ASTEROIDS];       // Velocity (1/256 px)
+static int16_t ast_vy[MAX_ASTEROIDS];
+static uint8_t ast_anim_frame[MAX_ASTEROIDS];   // Rotation step
+static int8_t ast_health[MAX_ASTEROIDS];        // Hit points
 
-// Globals
-asteroid_t ast_l[MAX_AST_L];
-asteroid_t ast_m[MAX_AST_M];
-asteroid_t ast_s[MAX_AST_S];
+static const uint8_t ast_first[3] = { 0, MAX_AST_L, MAX_AST_L + MAX_AST_M };
 
-// Config Addresses (From rpmegafighter.c)
-extern unsigned ASTEROID_L_CONFIG;
-extern unsigned ASTEROID_M_CONFIG;
-extern unsigned ASTEROID_S_CONFIG;
+// Live and free slots of each array
+POOL(ast_l_pool, MAX_AST_L);
+POOL(ast_m_pool, MAX_AST_M);
+POOL(ast_s_pool, MAX_AST_S);
+
+// Last config values written to XRAM for each sprite
+static sprite_shadow_t ast_l_shadow[MAX_AST_L];
+static sprite_shadow_t ast_m_shadow[MAX_AST_M];
+static sprite_shadow_t ast_s_shadow[MAX_AST_S];
+
+// Pools by AsteroidType
+static pool_t *const ast_pools[3] = { &ast_l_pool, &ast_m_pool, &ast_s_pool };
 
 
 extern void start_explosion(int16_t x, int16_t y);
 
 extern int16_t scroll_dx, scroll_dy;
-extern int player_score, enemy_score;
 
 // Asteroid World Boundaries
 #define AWORLD_PAD 100  // Extra padding beyond screen edges
@@ -51,73 +62,91 @@ extern int player_score, enemy_score;
 // INITIALIZATION
 // ---------------------------------------------------------
 void init_asteroids(void) {
+    sprite_shadow_reset(ast_l_shadow, MAX_AST_L);
+    sprite_shadow_reset(ast_m_shadow, MAX_AST_M);
+    sprite_shadow_reset(ast_s_shadow, MAX_AST_S);
+    pool_reset(&ast_l_pool);
+    pool_reset(&ast_m_pool);
+    pool_reset(&ast_s_pool);
+
     // 1. Reset Large (Affine)
     size_t size_l = sizeof(vga_mode4_asprite_t);
-    for (int i=0; i<MAX_AST_L; i++) {
-        ast_l[i].active = false;
+    for (uint8_t i = 0; i < MAX_AST_L; i++) {
         unsigned ptr = ASTEROID_L_CONFIG + (i * size_l);
-        xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100); // Hide
+        asprite_hide(ptr, &ast_l_shadow[i]);
     }
     
     // 2. Reset Medium (Standard)
     size_t size_std = sizeof(vga_mode4_sprite_t);
-    for (int i=0; i<MAX_AST_M; i++) {
-        ast_m[i].active = false;
+    for (uint8_t i = 0; i < MAX_AST_M; i++) {
         unsigned ptr = ASTEROID_M_CONFIG + (i * size_std);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_hide(ptr, &ast_m_shadow[i]);
     }
     
     // 3. Reset Small (Standard)
-    for (int i=0; i<MAX_AST_S; i++) {
-        ast_s[i].active = false;
+    for (uint8_t i = 0; i < MAX_AST_S; i++) {
         unsigned ptr = ASTEROID_S_CONFIG + (i * size_std);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_hide(ptr, &ast_s_shadow[i]);
     }
 }
 
 // ---------------------------------------------------------
 // SPAWNING
 // ---------------------------------------------------------
-// Internal helper to setup a specific asteroid
-static void activate_asteroid(asteroid_t *a, AsteroidType type) {
-    a->active = true;
-    a->type = type;
-    a->rx = 0; 
-    a->ry = 0;
-    a->anim_frame = random(0, MAX_ROTATION); // Random start angle
+// Internal helper to setup a specific asteroid (a is its ast_* entry)
+static void activate_asteroid(uint8_t a, AsteroidType type) {
+    ast_rx[a] = 0; 
+    ast_ry[a] = 0;
+    ast_anim_frame[a] = random(0, SHIP_ROTATION_MASK); // Random start angle
 
     // Spawn at Random World Edge (-512 to +512)
     // 50% chance X-Edge, 50% chance Y-Edge
     if (rand16() & 1) {
-        a->x = (rand16() & 1) ? AWORLD_X1 : AWORLD_X2;
-        a->y = (int16_t)random(0, AWORLD_Y) + AWORLD_Y2;
+        ast_x[a] = (rand16() & 1) ? AWORLD_X1 : AWORLD_X2;
+        ast_y[a] = (int16_t)random(0, AWORLD_Y) + AWORLD_Y2;
     } else {
-        a->x = (int16_t)random(0, AWORLD_X) + AWORLD_X2;
-        a->y = (rand16() & 1) ? AWORLD_Y2 : AWORLD_Y2;
+        ast_x[a] = (int16_t)random(0, AWORLD_X) + AWORLD_X2;
+        ast_y[a] = (rand16() & 1) ? AWORLD_Y2 : AWORLD_Y2;
     }
 
     // Velocity (Slower for Large, Faster for Small)
     int speed_base = (type == AST_LARGE) ? 64 : ((type == AST_MEDIUM) ? 128 : 256);
-    a->vx = (rand16() & 1) ? speed_base : -speed_base;
-    a->vy = (rand16() & 1) ? speed_base : -speed_base;
+    ast_vx[a] = (rand16() & 1) ? speed_base : -speed_base;
+    ast_vy[a] = (rand16() & 1) ? speed_base : -speed_base;
 
     // Health
-    if (type == AST_LARGE) a->health = 20;
-    else if (type == AST_MEDIUM) a->health = 10;
-    else a->health = 2;
+    if (type == AST_LARGE) ast_health[a] = 20;
+    else if (type == AST_MEDIUM) ast_health[a] = 10;
+    else ast_health[a] = 2;
+
+}
 
+#ifdef STRESS_TEST
+static void stress_fill_pool(AsteroidType type) {
+    uint8_t i;
+    while ((i = pool_alloc(ast_pools[type])) != POOL_NONE) {
+        uint8_t a = ast_first[type] + i;
+        activate_asteroid(a, type);
+        ast_x[a] = (int16_t)random(0, SCREEN_WIDTH - 32);
+        ast_y[a] = (int16_t)random(0, SCREEN_HEIGHT - 32);
+    }
+}
+
+void stress_fill_asteroids(void) {
+    stress_fill_pool(AST_LARGE);
+    stress_fill_pool(AST_MEDIUM);
+    stress_fill_pool(AST_SMALL);
 }
+#endif
 
 void spawn_asteroid_wave(int level) {
     // Only spawn Large for now
-    // 2% chance per frame to try spawning
-    if (rand16() % 100 < 2) {
-        for (int i = 0; i < MAX_AST_L; i++) {
-            if (!ast_l[i].active) {
-                activate_asteroid(&ast_l[i], AST_LARGE);
-                printf("Spawned Large Asteroid %d at %d, %d\n", i, ast_l[i].x, ast_l[i].y);
-                break; // Only spawn one per frame
-            }
+    // 2% chance per frame to try spawning (5/256)
+    if (rand8() < 5) {
+        uint8_t i = pool_alloc(&ast_l_pool);
+        if (i != POOL_NONE) {
+            activate_asteroid(i, AST_LARGE);
+            printf("Spawned Large Asteroid %d at %d, %d\n", i, ast_x[i], ast_y[i]);
         }
     }
 }
@@ -125,105 +154,87 @@ void spawn_asteroid_wave(int level) {
 // ---------------------------------------------------------
 // UPDATE & RENDER
 // ---------------------------------------------------------
-static void update_single(asteroid_t *a, int index, unsigned base_cfg, int size_bytes) {
+static void update_single(uint8_t a, AsteroidType type, uint8_t index, unsigned base_cfg, int size_bytes, sprite_shadow_t *shadow) {
     // 1. Movement (Fixed Point)
-    a->rx += a->vx; if (a->rx >= 256) { a->x++; a->rx -= 256; } else if (a->rx <= -256) { a->x--; a->rx += 256; }
-    a->ry += a->vy; if (a->ry >= 256) { a->y++; a->ry -= 256; } else if (a->ry <= -256) { a->y--; a->ry += 256; }
+    ast_rx[a] += ast_vx[a]; if (ast_rx[a] >= 256) { ast_x[a]++; ast_rx[a] -= 256; } else if (ast_rx[a] <= -256) { ast_x[a]--; ast_rx[a] += 256; }
+    ast_ry[a] += ast_vy[a]; if (ast_ry[a] >= 256) { ast_y[a]++; ast_ry[a] -= 256; } else if (ast_ry[a] <= -256) { ast_y[a]--; ast_ry[a] += 256; }
 
     // 2. World Wrap (AWORLD_X1 to AWORLD_X2) & (AWORLD_Y1 to AWORLD_Y2)
-    if (a->x < AWORLD_X1) a->x += AWORLD_X; else if (a->x > AWORLD_X2) a->x -= AWORLD_X;
-    if (a->y < AWORLD_Y1) a->y += AWORLD_Y; else if (a->y > AWORLD_Y2) a->y -= AWORLD_Y;
+    if (ast_x[a] < AWORLD_X1) ast_x[a] += AWORLD_X; else if (ast_x[a] > AWORLD_X2) ast_x[a] -= AWORLD_X;
+    if (ast_y[a] < AWORLD_Y1) ast_y[a] += AWORLD_Y; else if (ast_y[a] > AWORLD_Y2) ast_y[a] -= AWORLD_Y;
+
 
+    ast_x[a] -= scroll_dx;
+    ast_y[a] -= scroll_dy;
 
-    a->x -= scroll_dx;
-    a->y -= scroll_dy;
+    // Centre of the 32/16/8 pixel sprite
+    int16_t half = 16 >> type;
+    collide_add(CT_AST_L + type, index, ast_x[a] + half, ast_y[a] + half);
 
     // 3. Render
-    int sx = a->x;
-    int sy = a->y;
+    int sx = ast_x[a];
+    int sy = ast_y[a];
     unsigned ptr = base_cfg + (index * size_bytes);
 
-    if (a->type == AST_LARGE) {
+    if (type == AST_LARGE) {
         // --- LARGE (Affine Plane 1) ---
         // Rotate every 8th frame
         // printf("Game Frame: %d\n", game_frame);
         if (game_frame % 8 == 0) {
             // Alternate direction based on index (i)
             if (index & 1) {
-                a->anim_frame++; // Spin Clockwise
-                if (a->anim_frame >= MAX_ROTATION) a->anim_frame = 0;
+                ast_anim_frame[a] = (ast_anim_frame[a] + 1) & SHIP_ROTATION_MASK; // Spin Clockwise
             } else {
-                a->anim_frame--; // Spin Counter-Clockwise
-                if (a->anim_frame >= 250) a->anim_frame = MAX_ROTATION - 1; // Handle wrap
+                ast_anim_frame[a] = (ast_anim_frame[a] - 1) & SHIP_ROTATION_MASK; // Spin Counter-Clockwise
             }
-            // a->anim_frame--; // Spin Counter-Clockwise
-            // if (a->anim_frame >= 250) a->anim_frame = MAX_ROTATION - 1; // Handle wrap
         }
-        int r = a->anim_frame; 
+        // Update Matrix (Rotation), only uploaded when anim_frame changed
+        asprite_rotate(ptr, shadow, affine_ast_l, ast_anim_frame[a]);
 
-        // Update Matrix (Rotation)
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[0],  cos_fix[r]); // SX
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[1], -sin_fix[r]); // SHY
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[3],  sin_fix[r]); // SHX
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[4],  cos_fix[r]); // SY
-
-        int16_t tx = t2_fix32[r]; 
-        
-        // TY uses the inverse angle (24 - r)
-        // Check bounds just in case r > 24
-        int y_idx = (MAX_ROTATION - r);
-        if (y_idx < 0) y_idx += MAX_ROTATION; // Safety wrap
-        int16_t ty = t2_fix32[y_idx];
-
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[2], tx); // TX
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[5], ty); // TY
-
-        xram0_struct_set(ptr, vga_mode4_asprite_t, x_pos_px, sx);
-        xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, sy);
+        asprite_move(ptr, shadow, sx, sy);
     } 
     else {
         // --- MED/SMALL (Standard Plane 2) ---
         // Just position (no rotation logic yet)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, sx);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, sy);
+        sprite_move(ptr, shadow, sx, sy);
         
         // Ensure data ptr is set (simple safeguard)
-        uint16_t data = (a->type == AST_MEDIUM) ? ASTEROID_M_DATA : ASTEROID_S_DATA;
-        uint8_t lsize = (a->type == AST_MEDIUM) ? 4 : 3;
+        uint16_t data = (type == AST_MEDIUM) ? ASTEROID_M_DATA : ASTEROID_S_DATA;
+        uint8_t lsize = (type == AST_MEDIUM) ? 4 : 3;
         
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, data);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, lsize);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
+        sprite_image(ptr, shadow, data, lsize);
     }
 }
 
 void move_asteroids_offscreen(void) {
     // Loop through pools
-    for(int i=0; i<MAX_AST_L; i++) {
-        // update_single(&ast_l[i], i, ASTEROID_L_CONFIG, sizeof(vga_mode4_asprite_t));
+    for (uint8_t i = 0; i < MAX_AST_L; i++) {
         unsigned ptr = ASTEROID_L_CONFIG + (i * sizeof(vga_mode4_asprite_t));
-        xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
+        asprite_hide(ptr, &ast_l_shadow[i]);
     }
-    for(int i=0; i<MAX_AST_M; i++) {
+    for (uint8_t i = 0; i < MAX_AST_M; i++) {
         unsigned ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_hide(ptr, &ast_m_shadow[i]);
     }
-    for(int i=0; i<MAX_AST_S; i++) {
+    for (uint8_t i = 0; i < MAX_AST_S; i++) {
         unsigned ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_hide(ptr, &ast_s_shadow[i]);
     }
 }
 
-void update_asteroids(void) {
-    // Loop through pools
-    for(int i=0; i<MAX_AST_L; i++) {
-        if (ast_l[i].active) update_single(&ast_l[i], i, ASTEROID_L_CONFIG, sizeof(vga_mode4_asprite_t));
+PROFILED void update_asteroids(void) {
+    // Live rocks only
+    for (uint8_t k = ast_l_pool.count; k-- > 0; ) {
+        uint8_t i = ast_l_pool.slot[k];
+        update_single(ast_first[AST_LARGE] + i, AST_LARGE, i, ASTEROID_L_CONFIG, sizeof(vga_mode4_asprite_t), &ast_l_shadow[i]);
     }
-    for(int i=0; i<MAX_AST_M; i++) {
-        if (ast_m[i].active) update_single(&ast_m[i], i, ASTEROID_M_CONFIG, sizeof(vga_mode4_sprite_t));
+    for (uint8_t k = ast_m_pool.count; k-- > 0; ) {
+        uint8_t i = ast_m_pool.slot[k];
+        update_single(ast_first[AST_MEDIUM] + i, AST_MEDIUM, i, ASTEROID_M_CONFIG, sizeof(vga_mode4_sprite_t), &ast_m_shadow[i]);
     }
-    for(int i=0; i<MAX_AST_S; i++) {
-        if (ast_s[i].active) update_single(&ast_s[i], i, ASTEROID_S_CONFIG, sizeof(vga_mode4_sprite_t));
+    for (uint8_t k = ast_s_pool.count; k-- > 0; ) {
+        uint8_t i = ast_s_pool.slot[k];
+        update_single(ast_first[AST_SMALL] + i, AST_SMALL, i, ASTEROID_S_CONFIG, sizeof(vga_mode4_sprite_t), &ast_s_shadow[i]);
     }
 }
 
@@ -233,447 +244,114 @@ void update_asteroids(void) {
 
 // Helper to spawn a child asteroid at a specific spot with specific velocity
 static void spawn_child(AsteroidType type, int16_t x, int16_t y, int16_t vx, int16_t vy) {
-    asteroid_t *pool;
-    int max_count;
+    // Take a free slot
+    uint8_t i = pool_alloc(ast_pools[type]);
+    if (i == POOL_NONE) return;     // Pool full: no child
+    uint8_t a = ast_first[type] + i;
+
+    ast_x[a] = x;
+    ast_y[a] = y;
+    ast_rx[a] = 0; 
+    ast_ry[a] = 0;
+    ast_vx[a] = vx;
+    ast_vy[a] = vy;
+    ast_anim_frame[a] = 0;
     
-    // Select Pool
-    if (type == AST_MEDIUM) { pool = ast_m; max_count = MAX_AST_M; }
-    else { pool = ast_s; max_count = MAX_AST_S; }
-
-    // Find free slot
-    for (int i = 0; i < max_count; i++) {
-        if (!pool[i].active) {
-            pool[i].active = true;
-            pool[i].type = type;
-            pool[i].x = x;
-            pool[i].y = y;
-            pool[i].rx = 0; 
-            pool[i].ry = 0;
-            pool[i].vx = vx;
-            pool[i].vy = vy;
-            pool[i].anim_frame = 0;
-            
-            // Set Health
-            pool[i].health = (type == AST_MEDIUM) ? 6 : 1;
-            
-            // Set Config Immediately (So it doesn't wait for next update frame)
-            // unsigned ptr;
-            // if (type == AST_MEDIUM) {
-            //     ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-            //     xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, ASTEROID_M_DATA);
-            //     xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 4); // 16x16
-            // } else {
-            //     ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-            //     xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, ASTEROID_S_DATA);
-            //     xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 3); // 8x8
-            // }
-            // xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
-
-            printf("Spawning Child Type %d at %d,%d (Slot %d)\n", type, x, y, i);
-            
-            return; // Spawned successfully
-        }
-    }
+    // Set Health
+    ast_health[a] = (type == AST_MEDIUM) ? 6 : 1;
+    
+    // Set Config Immediately (So it doesn't wait for next update frame)
+    // unsigned ptr;
+    // if (type == AST_MEDIUM) {
+    //     ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
+    //     xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, ASTEROID_M_DATA);
+    //     xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 4); // 16x16
+    // } else {
+    //     ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
+    //     xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, ASTEROID_S_DATA);
+    //     xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 3); // 8x8
+    // }
+    // xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
+
+    printf("Spawning Child Type %d at %d,%d (Slot %d)\n", type, x, y, i);
 }
 
 // ---------------------------------------------------------
-// COLLISION LOGIC
+// COLLISION RESPONSES (see collision.c)
 // ---------------------------------------------------------
 
-bool check_asteroid_hit(int16_t bx, int16_t by) {
-    // 1. Check LARGE Asteroids (Radius ~14px)
-    for (int i = 0; i < MAX_AST_L; i++) {
-        if (!ast_l[i].active) continue;
-        
-        int16_t a_cx = ast_l[i].x + 16 - bx;
-        int16_t a_cy = ast_l[i].y + 16 - by;
-
-        // Simple Box Check (Faster than distance calc)
-        if (a_cx > -14 && a_cx < 14) {
-            if (a_cy > -14 && a_cy < 14) {
-                ast_l[i].health--;
-            
-                if (ast_l[i].health <= 0) {
-                    // DESTROY LARGE -> Spawn 2 Mediums
-                    ast_l[i].active = false;
-                    start_explosion(ast_l[i].x, ast_l[i].y);
-                    player_score += 5;
-
-                    // Split velocities (diverge from parent)
-                    // Parent velocity +/- 30 subpixels
-                    spawn_child(AST_MEDIUM, ast_l[i].x, ast_l[i].y, ast_l[i].vx + 128, ast_l[i].vy - 128);
-                    spawn_child(AST_MEDIUM, ast_l[i].x, ast_l[i].y, ast_l[i].vx - 128, ast_l[i].vy + 128);
-                    
-                    // Hide sprite immediately
-                    unsigned ptr = ASTEROID_L_CONFIG + (i * sizeof(vga_mode4_asprite_t));
-                    xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
-                }
-                return true; // Bullet hit something
-            }
-        }
-    }
+bool asteroid_live(AsteroidType type, uint8_t i) {
+    return pool_live(ast_pools[type], i);
+}
 
-    // 2. Check MEDIUM Asteroids (Radius ~7px)
-    for (int i = 0; i < MAX_AST_M; i++) {
-        if (!ast_m[i].active) continue;
+// Blow up an asteroid, splitting Large into 2 Mediums and Medium into 2 Smalls
+static void destroy_asteroid(AsteroidType type, uint8_t i) {
+    uint8_t a = ast_first[type] + i;
+    pool_free(ast_pools[type], i);
+    start_explosion(ast_x[a], ast_y[a]);
 
-        int16_t a_cx = ast_m[i].x + 8 - bx;
-        int16_t a_cy = ast_m[i].y + 8 - by;
-        
-        if (a_cx > -8 && a_cx < 8) {
-            if (a_cy > -8 && a_cy < 8) {
-                ast_m[i].health--;
-                
-                if (ast_m[i].health <= 0) {
-                    // DESTROY MEDIUM -> Spawn 2 Smalls
-                    ast_m[i].active = false;
-                    start_explosion(ast_m[i].x, ast_m[i].y);
-                    player_score += 2;
-
-                    // Make small ones fast! (+/- 60 subpixels)
-                    spawn_child(AST_SMALL, ast_m[i].x, ast_m[i].y, ast_m[i].vx + 128, ast_m[i].vy + 128);
-                    spawn_child(AST_SMALL, ast_m[i].x, ast_m[i].y, ast_m[i].vx - 128, ast_m[i].vy - 128);
-
-                    unsigned ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-                    xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-                }
-                return true;
-            }
-        }
-    }
+    if (type == AST_LARGE) {
+        unsigned ptr = ASTEROID_L_CONFIG + (i * sizeof(vga_mode4_asprite_t));
+        asprite_hide(ptr, &ast_l_shadow[i]);
 
-    // 3. Check SMALL Asteroids (Radius ~4px)
-    for (int i = 0; i < MAX_AST_S; i++) {
-        if (!ast_s[i].active) continue;
+        // Split velocities (diverge from parent)
+        spawn_child(AST_MEDIUM, ast_x[a], ast_y[a], ast_vx[a] + 128, ast_vy[a] - 128);
+        spawn_child(AST_MEDIUM, ast_x[a], ast_y[a], ast_vx[a] - 128, ast_vy[a] + 128);
+    } else if (type == AST_MEDIUM) {
+        unsigned ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
+        sprite_hide(ptr, &ast_m_shadow[i]);
 
-        int16_t a_cx = ast_s[i].x + 4 - bx;
-        int16_t a_cy = ast_s[i].y + 4 - by;
-        
-        // if (abs(a_cx - bx) < 5 && abs(a_cy - by) < 5) {
-        if (a_cx > -4 && a_cx < 4) {
-            if (a_cy > -4 && a_cy < 4) {
-                ast_s[i].health--; // Usually 1 hit kill
-                
-                if (ast_s[i].health <= 0) {
-                    // DESTROY SMALL -> Dust
-                    ast_s[i].active = false;
-                    start_explosion(ast_s[i].x, ast_s[i].y);
-                    player_score += 1;
-
-                    unsigned ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-                    xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-                }
-                return true;
-            }
-        }
+        // Make small ones fast!
+        spawn_child(AST_SMALL, ast_x[a], ast_y[a], ast_vx[a] + 128, ast_vy[a] + 128);
+        spawn_child(AST_SMALL, ast_x[a], ast_y[a], ast_vx[a] - 128, ast_vy[a] - 128);
+    } else {
+        // DESTROY SMALL -> Dust
+        unsigned ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
+        sprite_hide(ptr, &ast_s_shadow[i]);
     }
-
-    return false;
 }
 
-// ---------------------------------------------------------
-// FIGHTER COLLISION LOGIC
-// ---------------------------------------------------------
-
-// Returns true if the fighter at (fx, fy) crashed into a rock
-bool check_asteroid_hit_fighter(int16_t fx, int16_t fy) {
-    
-    // 1. Calculate Fighter Center
-    // Fighter is 4x4, center is +2
-    int16_t f_cx = fx + 2;
-    int16_t f_cy = fy + 2;
-
-    // -------------------------------------------------
-    // 1. Check LARGE Asteroids
-    // -------------------------------------------------
-    // ast_l.x is Top-Left of 32x32 box. Add 16 for Center.
-    // Collision Radius: Rock(14) + Fighter(2) = 16
-    for (int i = 0; i < MAX_AST_L; i++) {
-        if (!ast_l[i].active) continue;
-        
-        int16_t a_cx = ast_l[i].x + 16 - f_cx;
-        int16_t a_cy = ast_l[i].y + 16 - f_cy;
-        
-        // if (abs(a_cx - f_cx) < 16 && abs(a_cy - f_cy) < 16) {
-        if (a_cx > -16 && a_cx < 16) {
-            if (a_cy > -16 && a_cy < 16) {
-                ast_l[i].health -= 1;
-                
-                if (ast_l[i].health <= 0) {
-                    // Destroy
-                    ast_l[i].active = false;
-                    start_explosion(a_cx - 16, a_cy - 16); // Explosion uses top-left logic?
-                    
-                    // Hide sprite
-                    unsigned ptr = ASTEROID_L_CONFIG + (i * sizeof(vga_mode4_asprite_t));
-                    xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
-
-                    // Spawn Debris from Center
-                    int16_t spread = 50;
-                    spawn_child(AST_MEDIUM, a_cx, a_cy, ast_l[i].vx + spread, ast_l[i].vy - spread);
-                    spawn_child(AST_MEDIUM, a_cx, a_cy, ast_l[i].vx - spread, ast_l[i].vy + spread);
-                } // else {
-                //    start_explosion(fx, fy);
-                // }
-                return true;
-            }
-        }
-    }
-
-    // -------------------------------------------------
-    // 2. Check MEDIUM Asteroids
-    // -------------------------------------------------
-    // ast_m.x is Top-Left of 16x16. Add 8 for Center.
-    // Collision Radius: Rock(7) + Fighter(2) = 9
-    for (int i = 0; i < MAX_AST_M; i++) {
-        if (!ast_m[i].active) continue;
-        
-        int16_t a_cx = ast_m[i].x + 8 - f_cx;
-        int16_t a_cy = ast_m[i].y + 8 - f_cy;
-
-        // if (abs(a_cx - f_cx) < 9 && abs(a_cy - f_cy) < 9) {
-        if (a_cx > -9 && a_cx < 9) {
-            if (a_cy > -9 && a_cy < 9) {
-                ast_m[i].health -= 1;
-                
-                if (ast_m[i].health <= 0) {
-                    ast_m[i].active = false;
-                    start_explosion(ast_m[i].x, ast_m[i].y); // Pass Top-Left if start_explosion expects it
-
-                    unsigned ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-                    xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-
-                    int16_t spread = 80;
-                    // Spawn children from Center
-                    spawn_child(AST_SMALL, a_cx, a_cy, ast_m[i].vx + spread, ast_m[i].vy - spread);
-                    spawn_child(AST_SMALL, a_cx, a_cy, ast_m[i].vx - spread, ast_m[i].vy + spread);
-                }
-                return true;
-            }
-        }
+bool damage_asteroid(AsteroidType type, uint8_t i) {
+    uint8_t a = ast_first[type] + i;
+    ast_health[a]--;
+    if (ast_health[a] > 0) {
+        return false;
     }
-
-    // -------------------------------------------------
-    // 3. Check SMALL Asteroids
-    // -------------------------------------------------
-    // ast_s.x is Top-Left of 8x8. Add 4 for Center.
-    // Collision Radius: Rock(3) + Fighter(2) = 5
-    for (int i = 0; i < MAX_AST_S; i++) {
-        if (!ast_s[i].active) continue;
-        
-        int16_t a_cx = ast_s[i].x + 4 - f_cx;
-        int16_t a_cy = ast_s[i].y + 4 - f_cy;
-
-        // if (abs(a_cx - f_cx) < 5 && abs(a_cy - f_cy) < 5) {
-        if (a_cx > -4 && a_cx < 4) {
-            if (a_cy > -4 && a_cy < 4) {
-                ast_s[i].active = false;
-                start_explosion(ast_s[i].x, ast_s[i].y);
-
-                unsigned ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-                
-                return true;
-            }
-        }
-    }
-    
-    return false;
+    destroy_asteroid(type, i);
+    return true;
 }
 
-void check_player_asteroid_collision(int16_t px, int16_t py) {
-    // 1. Calculate Player Center (8x8 sprite)
-    int16_t p_cx = px + 4;
-    int16_t p_cy = py + 4;
-
-    // -------------------------------------------------
-    // 1. LARGE ASTEROIDS (Radius ~14)
-    // -------------------------------------------------
-    // Hitbox: 14 (Rock) + 3 (Player) = 17
-    for (int i = 0; i < MAX_AST_L; i++) {
-        if (!ast_l[i].active) continue;
-        
-        // Large uses centered coordinates due to Affine offset
-        int16_t a_cx = ast_l[i].x + 16;
-        int16_t a_cy = ast_l[i].y + 16;
-
-        if (abs(a_cx - p_cx) < 17 && abs(a_cy - p_cy) < 17) {
-            // CRASH INTO LARGE -> INSTANT GAME OVER
-            // enemy_score = 100; 
-            // start_explosion(px, py);
-            // printf("GAME OVER: Player hit Large Asteroid\n");
-            // return; // No need to check others
-
-            // --- NEW DEATH LOGIC ---
-            printf("CRASH! Triggering Death Sequence...\n");
-            
-            // 1. Start the first big explosion exactly at player position
-            start_explosion(px, py);
-            
-            // 2. Begin the 3-second drama
-            trigger_player_death();
-
-            // Use Index 32 (Red in Rainbow Palette) or 0x03 (Standard Red)
-            uint8_t text_color = 32; 
-            
-            // Centering math (approximate)
-            // Screen 320 wide. Text ~60px wide.
-            draw_text(110, 40, "YOU CRASHED...", text_color);
-            draw_text(125, 52, "GAME OVER", text_color);
-            
-            return;
-        }
+void player_hit_asteroid(AsteroidType type, uint8_t i) {
+    if (!asteroid_live(type, i)) {
+        return;     // Shot to pieces earlier this frame
     }
 
-    // -------------------------------------------------
-    // 2. MEDIUM ASTEROIDS (Radius ~7)
-    // -------------------------------------------------
-    // Hitbox: 7 (Rock) + 3 (Player) = 10
-    for (int i = 0; i < MAX_AST_M; i++) {
-        if (!ast_m[i].active) continue;
+    if (type == AST_LARGE) {
+        // CRASH INTO LARGE -> GAME OVER
+        printf("CRASH! Triggering Death Sequence...\n");
         
-        int16_t a_cx = ast_m[i].x + 8;
-        int16_t a_cy = ast_m[i].y + 8;
-
-        if (abs(a_cx - p_cx) < 10 && abs(a_cy - p_cy) < 10) {
-            // PENALTY: -20 Points
-            if (player_score >= 20) player_score -= 20; 
-            else player_score = 0;
-
-            // Destroy Rock
-            ast_m[i].active = false;
-            start_explosion(ast_m[i].x, ast_m[i].y);
-            
-            // Hide Sprite
-            unsigned ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-
-            // Split into Smalls
-            int16_t spread = 80;
-            spawn_child(AST_SMALL, a_cx, a_cy, ast_m[i].vx + spread, ast_m[i].vy - spread);
-            spawn_child(AST_SMALL, a_cx, a_cy, ast_m[i].vx - spread, ast_m[i].vy + spread);
-            
-            // Visual feedback
-            start_explosion(px, py);
-            return; // Prevent multi-hit in one frame
-        }
-    }
-
-    // -------------------------------------------------
-    // 3. SMALL ASTEROIDS (Radius ~3)
-    // -------------------------------------------------
-    // Hitbox: 3 (Rock) + 3 (Player) = 6
-    for (int i = 0; i < MAX_AST_S; i++) {
-        if (!ast_s[i].active) continue;
+        // 1. Start the first big explosion exactly at player position
+        start_explosion(player_x, player_y);
         
-        int16_t a_cx = ast_s[i].x + 4;
-        int16_t a_cy = ast_s[i].y + 4;
-
-        if (abs(a_cx - p_cx) < 6 && abs(a_cy - p_cy) < 6) {
-            // PENALTY: -10 Points
-            if (player_score >= 10) player_score -= 10;
-            else player_score = 0;
-
-            // Destroy Rock
-            ast_s[i].active = false;
-            start_explosion(ast_s[i].x, ast_s[i].y);
-
-            unsigned ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-            
-            start_explosion(px, py);
-            return;
-        }
-    }
-}
+        // 2. Begin the 3-second drama
+        trigger_player_death();
 
-// Same logic as standard hit, but 0 points awarded
-bool check_asteroid_hit_no_score(int16_t bx, int16_t by) {
-    
-    // ---------------------------------------------------------
-    // 1. Check LARGE Asteroids
-    // ---------------------------------------------------------
-    for (int i = 0; i < MAX_AST_L; i++) {
-        if (!ast_l[i].active) continue;
-        
-        // Large uses Centered Coords (Affine offset)
-        int16_t a_cx = ast_l[i].x + 16;
-        int16_t a_cy = ast_l[i].y + 16;
+        // Use Index 32 (Red in Rainbow Palette) or 0x03 (Standard Red)
+        uint8_t text_color = 32; 
         
-        // Radius 14 + Bullet 2 = 16
-        if (abs(a_cx - bx) < 16 && abs(a_cy - by) < 16) {
-            ast_l[i].health--; // 1 Damage
-            
-            if (ast_l[i].health <= 0) {
-                // Destroy & Split
-                ast_l[i].active = false;
-                start_explosion(ast_l[i].x, ast_l[i].y);
-                // NO POINTS AWARDED
-
-                unsigned ptr = ASTEROID_L_CONFIG + (i * sizeof(vga_mode4_asprite_t));
-                xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
-
-                int16_t spread = 50;
-                spawn_child(AST_MEDIUM, a_cx, a_cy, ast_l[i].vx + spread, ast_l[i].vy - spread);
-                spawn_child(AST_MEDIUM, a_cx, a_cy, ast_l[i].vx - spread, ast_l[i].vy + spread);
-            }
-            return true;
-        }
+        // Centering math (approximate)
+        // Screen 320 wide. Text ~60px wide.
+        draw_text(110, 40, "YOU CRASHED...", text_color);
+        draw_text(125, 52, "GAME OVER", text_color);
+        return;
     }
 
-    // ---------------------------------------------------------
-    // 2. Check MEDIUM Asteroids
-    // ---------------------------------------------------------
-    for (int i = 0; i < MAX_AST_M; i++) {
-        if (!ast_m[i].active) continue;
-        
-        // Medium uses Top-Left Coords
-        int16_t a_cx = ast_m[i].x + 8;
-        int16_t a_cy = ast_m[i].y + 8;
-
-        // Radius 8 + Bullet 2 = 10
-        if (abs(a_cx - bx) < 10 && abs(a_cy - by) < 10) {
-            ast_m[i].health--;
-            
-            if (ast_m[i].health <= 0) {
-                ast_m[i].active = false;
-                start_explosion(ast_m[i].x, ast_m[i].y);
-                
-                unsigned ptr = ASTEROID_M_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-
-                int16_t spread = 80;
-                spawn_child(AST_SMALL, a_cx, a_cy, ast_m[i].vx + spread, ast_m[i].vy - spread);
-                spawn_child(AST_SMALL, a_cx, a_cy, ast_m[i].vx - spread, ast_m[i].vy + spread);
-            }
-            return true;
-        }
-    }
+    // PENALTY: -20 Points for Medium, -10 for Small
+    bcd_t penalty = (type == AST_MEDIUM) ? 0x20 : 0x10;
+    player_score = bcd_sub(player_score, penalty);
 
-    // ---------------------------------------------------------
-    // 3. Check SMALL Asteroids
-    // ---------------------------------------------------------
-    for (int i = 0; i < MAX_AST_S; i++) {
-        if (!ast_s[i].active) continue;
-        
-        // Small uses Top-Left Coords
-        int16_t a_cx = ast_s[i].x + 4;
-        int16_t a_cy = ast_s[i].y + 4;
-
-        // Radius 4 + Bullet 2 = 6
-        if (abs(a_cx - bx) < 6 && abs(a_cy - by) < 6) {
-            ast_s[i].health--;
-            
-            if (ast_s[i].health <= 0) {
-                ast_s[i].active = false;
-                start_explosion(ast_s[i].x, ast_s[i].y);
-
-                unsigned ptr = ASTEROID_S_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-            }
-            return true;
-        }
-    }
+    destroy_asteroid(type, i);
 
-    return false;
-}
\ No newline at end of file
+    // Visual feedback
+    start_explosion(player_x, player_y);
+}
@@ -11,42 +11,29 @@ typedef enum {
     AST_SMALL
 } AsteroidType;
 
-// Object Structure
-typedef struct {
-    bool active;
-    int16_t x, y;       // World Position
-    int16_t rx, ry;     // Sub-pixel remainders (for smooth movement)
-    int16_t vx, vy;     // Velocity (Speed)
-    uint8_t anim_frame; // For rotation/animation
-    int8_t health;      // Hit points
-    AsteroidType type;
-} asteroid_t;
-
 // Pools
 #define MAX_AST_L 2
 #define MAX_AST_M 4
 #define MAX_AST_S 8
 
-extern asteroid_t ast_l[MAX_AST_L];
-extern asteroid_t ast_m[MAX_AST_M];
-extern asteroid_t ast_s[MAX_AST_S];
-
 // Functions
 void init_asteroids(void);
 void spawn_asteroid_wave(int level); // Call every frame
 void update_asteroids(void);         // Call every frame
 void move_asteroids_offscreen(void); // Move all asteroids offscreen (for screen transitions)
 
-// Returns true if the bullet hit an asteroid (so the bullet should die)
-bool check_asteroid_hit(int16_t x, int16_t y);
+// Collision responses (see collision.c)
+bool asteroid_live(AsteroidType type, uint8_t i);
 
-// Returns true if the fighter at (fx, fy) crashed into a rock
-bool check_asteroid_hit_fighter(int16_t fx, int16_t fy);
+// One point of damage; returns true if that destroyed (and split) the rock
+bool damage_asteroid(AsteroidType type, uint8_t i);
 
-// Checks collision between Player and all Asteroids
-// Modifies scores and destroys asteroids if hit
-void check_player_asteroid_collision(int16_t px, int16_t py);
+// The player flew into a rock: Large is fatal, Medium and Small cost points
+void player_hit_asteroid(AsteroidType type, uint8_t i);
 
-bool check_asteroid_hit_no_score(int16_t x, int16_t y);
+#ifdef STRESS_TEST
+// Stress mode: activate every free slot in all three pools on screen
+void stress_fill_asteroids(void);
+#endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "bcd.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+// Each helper walks the value a byte at a time from the low end, shifting
+// the operands right by 8 and the finished byte in from the top, so every
+// shift is a whole-byte move.
+
+bcd_t bcd_add(bcd_t a, bcd_t b)
+{
+    bcd_t sum = 0;
+    uint8_t carry = 0;
+
+    for (uint8_t k = 0; k < 4; k++) {
+        uint8_t x = (uint8_t)a;
+        uint8_t y = (uint8_t)b;
+        uint8_t lo = (x & 0x0F) + (y & 0x0F) + carry;
+        uint8_t hi = (x >> 4) + (y >> 4);
+        if (lo > 9) {
+            lo -= 10;
+            hi++;
+        }
+        carry = (hi > 9);
+        if (carry) hi -= 10;
+
+        sum = (sum >> 8) | ((bcd_t)((hi << 4) | lo) << 24);
+        a >>= 8;
+        b >>= 8;
+    }
+    return sum;
+}
+
+bcd_t bcd_sub(bcd_t a, bcd_t b)
+{
+    if (b >= a) return 0;
+
+    bcd_t diff = 0;
+    uint8_t borrow = 0;
+
+    for (uint8_t k = 0; k < 4; k++) {
+        uint8_t x = (uint8_t)a;
+        uint8_t y = (uint8_t)b;
+        int8_t lo = (int8_t)(x & 0x0F) - (int8_t)(y & 0x0F) - borrow;
+        int8_t hi = (int8_t)(x >> 4) - (int8_t)(y >> 4);
+        if (lo < 0) {
+            lo += 10;
+            hi--;
+        }
+        borrow = (hi < 0);
+        if (borrow) hi += 10;
+
+        diff = (diff >> 8) | ((bcd_t)(((uint8_t)hi << 4) | (uint8_t)lo) << 24);
+        a >>= 8;
+        b >>= 8;
+    }
+    return diff;
+}
+
+bcd_t bcd_from_u8(uint8_t n)
+{
+    uint16_t bcd = 0;
+
+    // Shift n in a bit at a time. A digit of 5 or more would pass 9 when
+    // doubled, so adding 3 first makes the doubling carry into the next one.
+    for (uint8_t b = 0; b < 8; b++) {
+        if ((bcd & 0x0F) >= 0x05) bcd += 0x03;
+        if ((bcd & 0xF0) >= 0x50) bcd += 0x30;
+        bcd = (bcd << 1) | (n >> 7);
+        n <<= 1;
+    }
+    return bcd;
+}
+
+void bcd_digits(char *out, bcd_t v, uint8_t digits)
+{
+    while (digits-- > 0) {
+        out[digits] = '0' + ((uint8_t)v & 0x0F);
+        v >>= 4;
+    }
+}
+
+bool bcd_valid(bcd_t v)
+{
+    for (uint8_t k = 0; k < 8; k++) {
+        if ((v & 0x0F) > 9) return false;
+        v >>= 4;
+    }
+    return true;
+}
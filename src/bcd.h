@@ -0,0 +1,45 @@
+#ifndef BCD_H
+#define BCD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * bcd.h - Packed BCD score counters
+ *
+ * Scores are kept in packed BCD, one decimal digit per nibble (the score
+ * 1234 is 0x1234), so drawing one takes a nibble-to-glyph per digit and no
+ * division. Packed BCD values order the same as the numbers they hold, so
+ * scores compare with the plain operators; only arithmetic needs the
+ * helpers below, which apply the decimal-mode carry rules a byte at a time.
+ */
+
+typedef uint32_t bcd_t;     // Up to 8 digits
+
+/**
+ * a + b (digits past the eighth are dropped)
+ */
+bcd_t bcd_add(bcd_t a, bcd_t b);
+
+/**
+ * a - b, or 0 if b is larger
+ */
+bcd_t bcd_sub(bcd_t a, bcd_t b);
+
+/**
+ * Binary 0-255 to BCD, with shifts and adds only (double dabble)
+ */
+bcd_t bcd_from_u8(uint8_t n);
+
+/**
+ * Write the lowest digits of v to out as ASCII, most significant first
+ * (out is not terminated)
+ */
+void bcd_digits(char *out, bcd_t v, uint8_t digits);
+
+/**
+ * True if every nibble of v is a decimal digit
+ */
+bool bcd_valid(bcd_t v);
+
+#endif // BCD_H
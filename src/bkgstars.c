@@ -26,7 +26,7 @@ void init_stars(void)
     }
 }
 
-void draw_stars(int16_t dx, int16_t dy) 
+PROFILED void draw_stars(int16_t dx, int16_t dy) 
 {
     for (uint8_t i = 0; i < NSTAR; i++) {
         // Clear previous star position
@@ -8,6 +8,9 @@
 #include "graphics.h"
 #include "bomber.h"
 #include "player.h"
+#include "collision.h"
+#include "explosions.h"
+#include "sprite_shadow.h"
 
 // Bomber State
 typedef struct {
@@ -24,7 +27,19 @@ extern int16_t earth_x, earth_y;
 
 bomber_t bomber = { .active = false };
 
-void spawn_bomber(int level) {
+// Last image and position written to the bomber's sprite config
+static sprite_shadow_t bomber_shadow;
+
+void init_bomber(void) {
+    bomber.active = false;
+    sprite_shadow_reset(&bomber_shadow, 1);
+}
+
+void move_bomber_offscreen(void) {
+    sprite_hide(BOMBER_CONFIG, &bomber_shadow);
+}
+
+void spawn_bomber(int16_t level) {
     if (bomber.active) return;
 
     bomber.active = true;
@@ -67,16 +82,14 @@ void spawn_bomber(int level) {
     }
 
     // Initialize Sprite Config (Mode 4 Swarm)
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, xram_sprite_ptr, BOMBER_DATA);
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, log_size, 3); // 3 = 8x8
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, has_opacity_metadata, false);
+    sprite_image(BOMBER_CONFIG, &bomber_shadow, BOMBER_DATA, 3); // 3 = 8x8
     
     printf("WARNING: Bomber Spawned at %d, %d\n", (int)bomber.x, (int)bomber.y);
 }
 
 void update_bomber(void) {
     if (!bomber.active) {
-        xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+        move_bomber_offscreen();
         return;
     }
 
@@ -148,8 +161,8 @@ void update_bomber(void) {
     // 4. RENDER
     // ---------------------------------------------------------
     // No casting needed, values are stable integers
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, x_pos_px, bomber.x);
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, y_pos_px, bomber.y);
+    sprite_move(BOMBER_CONFIG, &bomber_shadow, bomber.x, bomber.y);
+    collide_add(CT_BOMBER, 0, bomber.x + 4, bomber.y + 4);
 
     // ---------------------------------------------------------
     // 5. COLLISION (Using Earth struct properties)
@@ -172,4 +185,15 @@ void update_bomber(void) {
     //      game_over = true;
     //      printf("Earth has been destroyed!\n");
     // }
-}
\ No newline at end of file
+}
+
+void damage_bomber(void) {
+    if (!bomber.active) return;
+
+    bomber.health--;
+    if (bomber.health <= 0) {
+        bomber.active = false;
+        start_explosion(bomber.x, bomber.y);
+        move_bomber_offscreen();
+    }
+}
@@ -1,7 +1,17 @@
 #ifndef BOMBER_H
 #define BOMBER_H
 
+// Clear the bomber and forget its sprite shadow (after the config image is
+// reloaded)
+void init_bomber(void);
+
+// Park the bomber sprite off screen
+void move_bomber_offscreen(void);
+
 void spawn_bomber(int16_t level);
 void update_bomber(void);
 
+// A player bullet hit the bomber (see collision.c)
+void damage_bomber(void);
+
 #endif // BOMBER_H
\ No newline at end of file
@@ -7,6 +7,10 @@
 #include <stdbool.h>
 #include "sbullets.h"
 #include "asteroids.h"
+#include "sprite_shadow.h"
+#include "collision.h"
+#include "trig_tables.h"
+#include "fixed.h"
 #include <stdio.h>
 
 // ============================================================================
@@ -17,129 +21,97 @@
 // EXTERNAL DEPENDENCIES
 // ============================================================================
 
-// Game state from main
-extern int16_t player_score;
-extern int16_t game_score;
-
-// Sprite configuration addresses
-extern unsigned BULLET_CONFIG;
-
 // Lookup tables from definitions.h
-extern const int16_t sin_fix[25];
-extern const int16_t cos_fix[25];
-
-// Collision check from fighters module
-extern bool check_asteroid_hit(int16_t x, int16_t y);
-
-// Collision check from asteroids module
-// extern bool check_asteroid_hit(int16_t bx, int16_t by);
 
 // ============================================================================
 // MODULE STATE
 // ============================================================================
 
-// Player bullets (exported for use by player.c)
-Bullet bullets[MAX_BULLETS];
+// Player bullets, one array per field (exported for use by player.c)
+int16_t bullet_x[MAX_BULLETS];
+int16_t bullet_y[MAX_BULLETS];
+int8_t bullet_status[MAX_BULLETS];      // -1 = inactive, else direction step
+uint8_t bullet_vx_rem[MAX_BULLETS];     // Sub-pixel remainders, 0-63
+uint8_t bullet_vy_rem[MAX_BULLETS];
+sprite_shadow_t bullet_shadow[MAX_BULLETS];
 uint8_t current_bullet_index = 0;
 
-// Spread shot bullets (internal to this module for now)
-static Bullet sbullets[MAX_SBULLETS];
-// static uint16_t sbullet_cooldown = 0;
-// static uint8_t current_sbullet_index = 0;
-
 // ============================================================================
 // FUNCTIONS
 // ============================================================================
 
 void init_bullets(void)
 {
+    sprite_shadow_reset(bullet_shadow, MAX_BULLETS);
+
     for (uint8_t i = 0; i < MAX_BULLETS; i++) {
-        bullets[i].status = -1;
-        bullets[i].x = 0;
-        bullets[i].y = 0;
-        bullets[i].vx_rem = 0;
-        bullets[i].vy_rem = 0;
+        bullet_status[i] = -1;
+        bullet_x[i] = 0;
+        bullet_y[i] = 0;
+        bullet_vx_rem[i] = 0;
+        bullet_vy_rem[i] = 0;
     }
     
-    // Note: ebullets initialized in init_fighters()
-    
-    for (uint8_t i = 0; i < MAX_SBULLETS; i++) {
-        sbullets[i].status = -1;
-    }
+    // Note: ebullets initialized in init_fighters(), sbullets in
+    // init_sbullets()
 }
 
-void update_bullets(void)
+PROFILED void update_bullets(void)
 {
     for (uint8_t i = 0; i < MAX_BULLETS; i++) {
-        if (bullets[i].status < 0) {
+        if (bullet_status[i] < 0) {
             // Move sprite offscreen when inactive
             unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_hide(ptr, &bullet_shadow[i]);
             continue;  // Bullet is inactive
         }
         
-        // Check collision with fighters before moving
-        if (check_bullet_fighter_collision(bullets[i].x, bullets[i].y, &player_score, &game_score)) {
-            // Hit! Remove bullet
-            bullets[i].status = -1;
-            
-            // Move bullet sprite offscreen
-            unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-            
-            goto next_bullet;  // Skip rest of bullet update
-        }
-
-        // --- NEW: Check Asteroid Collision ---
-        if ((i & 1) == (game_frame & 1)) {
-            // printf("Game Frame: %d, Checking asteroid collision for bullet %d at (%d,%d)\n", 
-            //        game_frame, i, bullets[i].x, bullets[i].y);
-            if (check_asteroid_hit(bullets[i].x, bullets[i].y)) {
-                bullets[i].status = -1; // Kill bullet
-                
-                // Hide bullet sprite immediately
-                unsigned ptr = BULLET_CONFIG + (i * sizeof(vga_mode4_sprite_t));
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-                
-                goto next_bullet; // Move to next bullet
-            }
-        }
-        
         // Get velocity components based on bullet direction
-        int16_t bvx = -sin_fix[bullets[i].status];
-        int16_t bvy = -cos_fix[bullets[i].status];
+        int16_t bvx = -sin_fix[bullet_status[i]];
+        int16_t bvy = -cos_fix[bullet_status[i]];
         
         // Apply velocity with fixed-point math (divide by 64 for bullet speed)
-        int16_t bvx_applied = (bvx + bullets[i].vx_rem) >> 6;
-        int16_t bvy_applied = (bvy + bullets[i].vy_rem) >> 6;
-        
-        // Update remainder
-        bullets[i].vx_rem = bvx + bullets[i].vx_rem - (bvx_applied << 6);
-        bullets[i].vy_rem = bvy + bullets[i].vy_rem - (bvy_applied << 6);
+        int16_t bvx_applied = fx_step8(bvx, &bullet_vx_rem[i], BULLET_VEL_FRAC);
+        int16_t bvy_applied = fx_step8(bvy, &bullet_vy_rem[i], BULLET_VEL_FRAC);
         
         // Update bullet position
-        bullets[i].x += bvx_applied;
-        bullets[i].y += bvy_applied;
+        bullet_x[i] += bvx_applied;
+        bullet_y[i] += bvy_applied;
         
         // Check if bullet is still on screen
-        if (bullets[i].x > 0 && bullets[i].x < SCREEN_WIDTH && 
-            bullets[i].y > 0 && bullets[i].y < SCREEN_HEIGHT) {
+        if (bullet_x[i] > 0 && bullet_x[i] < SCREEN_WIDTH && 
+            bullet_y[i] > 0 && bullet_y[i] < SCREEN_HEIGHT) {
             // Update sprite hardware position
             unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, bullets[i].x);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, bullets[i].y);
+            sprite_move(ptr, &bullet_shadow[i], bullet_x[i], bullet_y[i]);
+            collide_add(CT_BULLET, i, bullet_x[i], bullet_y[i]);
         } else {
             // Bullet went off screen, deactivate it
-            bullets[i].status = -1;
+            bullet_status[i] = -1;
             // Move sprite offscreen
             unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_hide(ptr, &bullet_shadow[i]);
         }
-        
-    next_bullet:
-        continue;
+    }
+}
+
+bool bullet_live(uint8_t i)
+{
+    return bullet_status[i] >= 0;
+}
+
+void kill_bullet(uint8_t i)
+{
+    bullet_status[i] = -1;
+    unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
+    sprite_hide(ptr, &bullet_shadow[i]);
+}
+
+void move_bullets_offscreen(void)
+{
+    for (uint8_t i = 0; i < MAX_BULLETS; i++) {
+        unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
+        sprite_hide(ptr, &bullet_shadow[i]);
+        bullet_status[i] = -1;
     }
 }
@@ -2,20 +2,16 @@
 #define BULLETS_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /**
  * bullets.h - Player bullet management system
  * 
- * Handles player bullet firing, movement, and collision detection
+ * Handles player bullet firing, movement, and collision detection.
+ * Bullets are kept as one array per field (bullet_x[], bullet_status[],
+ * ...) so every access is a plain indexed load.
  */
 
-// Bullet structure
-typedef struct {
-    int16_t x, y;           // Position
-    int16_t status;         // -1 = inactive, 0-23 = active with direction
-    int16_t vx_rem, vy_rem; // Velocity remainder for sub-pixel movement
-} Bullet;
-
 /**
  * Initialize player bullet system
  */
@@ -24,9 +20,20 @@ void init_bullets(void);
 /**
  * Update all active player bullets
  * - Move bullets based on direction
- * - Check collisions with enemies
+ * - Register them for run_collisions()
  * - Remove off-screen bullets
  */
 void update_bullets(void);
 
+/**
+ * Deactivate all player bullets and move their sprites offscreen
+ */
+void move_bullets_offscreen(void);
+
+/**
+ * Collision responses (see collision.c): a killed bullet is hidden
+ */
+bool bullet_live(uint8_t i);
+void kill_bullet(uint8_t i);
+
 #endif // BULLETS_H
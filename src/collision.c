@@ -0,0 +1,501 @@
+#include "collision.h"
+#include "constants.h"
+#include "asteroids.h"
+#include "bullets.h"
+#include "sbullets.h"
+#include "fighters.h"
+#include "powerup.h"
+#include "bomber.h"
+#include "fixed.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+// One slot per entity that can ever be live, grouped by type
+#define SLOT_PLAYER     0
+#define SLOT_FIGHTER    (SLOT_PLAYER + 1)
+#define SLOT_EBULLET    (SLOT_FIGHTER + MAX_FIGHTERS)
+#define SLOT_BULLET     (SLOT_EBULLET + MAX_EBULLETS)
+#define SLOT_SBULLET    (SLOT_BULLET + MAX_BULLETS)
+#define SLOT_AST_L      (SLOT_SBULLET + MAX_SBULLETS)
+#define SLOT_AST_M      (SLOT_AST_L + MAX_AST_L)
+#define SLOT_AST_S      (SLOT_AST_M + MAX_AST_M)
+#define SLOT_POWERUP    (SLOT_AST_S + MAX_AST_S)
+#define SLOT_BOMBER     (SLOT_POWERUP + 1)
+#define COLLIDE_SLOTS   (SLOT_BOMBER + 1)
+
+// Slots not registered this frame sort to the end
+#define COLLIDE_DEAD    INT16_MAX
+
+// How far right the sweep looks: the largest projectile reach plus how far
+// a projectile pair can close over the frames the swept paths cover (EBL
+// against AST_L: 16 + 12 per frame, 28 for a one-frame path). No swept
+// path can start outside it. Pairs within the horizon are measured to
+// schedule their class; anything further apart is at least this far.
+#define COLLIDE_REACH_MAX   16
+#define COLLIDE_CLOSING_MAX 12
+
+// Pair tests per frame. A sweep that runs out, of tests or of room in the
+// hit list, resumes where it stopped on the next frame, and no class
+// sleeps on a partial sweep.
+#define COLLIDE_BUDGET  128
+
+// Once the swept paths span more frames than this, the sweep runs without
+// a budget. Each cut widens the horizon, so under sustained load a
+// budgeted sweep would never finish; this bounds both.
+#define MAX_PATH_FRAMES 4
+
+// Longest a pair class may go unchecked, in frames
+#define MAX_WAIT        8
+
+// Hits resolved per frame; the sweep stops when the list is full
+#define MAX_HITS        32
+
+// Pair classes: one per type pair with a nonzero reach
+#define MAX_CLASSES     24
+#define NO_CLASS        0xFF
+
+// ============================================================================
+// EXTERNAL DEPENDENCIES
+// ============================================================================
+
+extern bcd_t game_score;
+extern int16_t game_level;
+
+// ============================================================================
+// INTERACTION TABLE
+// ============================================================================
+
+static const uint8_t type_base[CT_TYPES] = {
+    SLOT_PLAYER, SLOT_FIGHTER, SLOT_EBULLET, SLOT_BULLET, SLOT_SBULLET,
+    SLOT_AST_L, SLOT_AST_M, SLOT_AST_S, SLOT_POWERUP, SLOT_BOMBER
+};
+
+// Reach between centres for each type pair (symmetric). Centres are the
+// middle of each sprite (player 8x8, fighter 4x4, ebullet 2x2, asteroids
+// 32/16/8, power-up and bomber 8x8); bullets are points.
+static const uint8_t reach[CT_TYPES][CT_TYPES] = {
+    //            PLY FTR EBL BUL SBL AL  AM  AS  PWR BMB
+    /* PLAYER  */ { 0,  6,  5,  0,  0, 17, 10,  6, 12,  0 },
+    /* FIGHTER */ { 6,  0,  0,  4,  4, 16,  9,  4,  0,  0 },
+    /* EBULLET */ { 5,  0,  0,  0,  0, 16, 10,  6,  0,  0 },
+    /* BULLET  */ { 0,  4,  0,  0,  0, 14,  8,  4,  0,  6 },
+    /* SBULLET */ { 0,  4,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* AST_L   */ {17, 16, 16, 14,  0,  0,  0,  0,  0,  0 },
+    /* AST_M   */ {10,  9, 10,  8,  0,  0,  0,  0,  0,  0 },
+    /* AST_S   */ { 6,  4,  6,  4,  0,  0,  0,  0,  0,  0 },
+    /* POWERUP */ {12,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* BOMBER  */ { 0,  0,  0,  6,  0,  0,  0,  0,  0,  0 },
+};
+
+// Fastest an entity of each type moves on screen, in pixels per frame along
+// either axis, scrolling included. Two entities close their gap by at most
+// the sum of their speeds each frame.
+static const uint8_t max_speed[CT_TYPES] = {
+    //  PLY FTR EBL BUL SBL AL  AM  AS  PWR BMB
+        3,  5,  7,  4,  4,  5,  5,  5,  4,  4
+};
+
+// Types that move far enough per frame to skip over a small box. Pairs
+// involving one are tested along the whole path since the last sweep, not
+// just where they ended up.
+static const bool projectile[CT_TYPES] = {
+    //  PLY    FTR    EBL   BUL   SBL   AL     AM     AS     PWR    BMB
+        false, false, true, true, true, false, false, false, false, false
+};
+
+// Points for shooting an asteroid to pieces, by AsteroidType
+static const bcd_t asteroid_points[3] = { 0x5, 0x2, 0x1 };
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static int16_t slot_x[COLLIDE_SLOTS];
+static int16_t slot_y[COLLIDE_SLOTS];
+static uint8_t slot_type[COLLIDE_SLOTS];
+
+static int16_t last_x[COLLIDE_SLOTS];       // Position at the last full
+static int16_t last_y[COLLIDE_SLOTS];       // sweep, or COLLIDE_DEAD if not
+static uint8_t path_frames;                 // registered; frames since then
+static int16_t horizon;                     // Sweep reach for path_frames
+
+// Slots in ascending x. Kept between frames, so the insertion sort only has
+// to fix up what moved.
+static uint8_t order[COLLIDE_SLOTS];
+static int16_t sort_x[COLLIDE_SLOTS];       // Sort key; COLLIDE_DEAD if out
+static uint8_t sweep_start;                 // Where a cut-short sweep resumes
+
+// Pair class scheduling. A class is due when its wait is 0; otherwise its
+// closest pair was far enough apart last time that it cannot touch for
+// that many frames.
+static uint8_t pair_class[CT_TYPES][CT_TYPES];
+static uint8_t class_count;
+static uint8_t class_type_a[MAX_CLASSES];
+static uint8_t class_type_b[MAX_CLASSES];
+static uint8_t class_wait[MAX_CLASSES];
+static bool class_due[MAX_CLASSES];
+static int16_t class_gap[MAX_CLASSES];      // Closest approach seen this frame
+static uint8_t type_count[CT_TYPES];        // Registered this frame
+
+// Overlapping pairs found by the sweep, lower type first
+static uint8_t hit_a[MAX_HITS];
+static uint8_t hit_b[MAX_HITS];
+static uint8_t hit_count;
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+void init_collisions(void)
+{
+    for (uint8_t t = 0; t < CT_TYPES; t++) {
+        uint8_t end = (t + 1 < CT_TYPES) ? type_base[t + 1] : COLLIDE_SLOTS;
+        for (uint8_t s = type_base[t]; s < end; s++) {
+            slot_type[s] = t;
+        }
+    }
+    for (uint8_t s = 0; s < COLLIDE_SLOTS; s++) {
+        order[s] = s;
+        sort_x[s] = COLLIDE_DEAD;
+        last_x[s] = COLLIDE_DEAD;
+    }
+    sweep_start = 0;
+    path_frames = 1;
+
+    class_count = 0;
+    for (uint8_t ta = 0; ta < CT_TYPES; ta++) {
+        for (uint8_t tb = ta; tb < CT_TYPES; tb++) {
+            uint8_t c = NO_CLASS;
+            if (reach[ta][tb] != 0 && class_count < MAX_CLASSES) {
+                c = class_count++;
+                class_type_a[c] = ta;
+                class_type_b[c] = tb;
+                class_wait[c] = 0;
+            }
+            pair_class[ta][tb] = c;
+            pair_class[tb][ta] = c;
+        }
+    }
+    collide_begin();
+}
+
+void collide_begin(void)
+{
+    for (uint8_t s = 0; s < COLLIDE_SLOTS; s++) {
+        slot_x[s] = COLLIDE_DEAD;
+    }
+}
+
+/**
+ * Decide which pair classes are due this frame, and which entities take
+ * part in the sort at all: a type whose every class is asleep stays out.
+ */
+static void schedule_classes(void)
+{
+    bool type_due[CT_TYPES];
+
+    for (uint8_t t = 0; t < CT_TYPES; t++) {
+        type_count[t] = 0;
+    }
+
+    // Anything that appeared since the last sweep (a shot, a split, a
+    // respawn) or jumped (a world wrap) was not where the sleeping classes
+    // measured it, so wake its classes. It has no path to sweep either, so
+    // it starts one from where it is now.
+    for (uint8_t s = 0; s < COLLIDE_SLOTS; s++) {
+        int16_t x = slot_x[s];
+        if (x == COLLIDE_DEAD) continue;
+
+        uint8_t t = slot_type[s];
+        uint16_t limit = fx_mul8(max_speed[t], path_frames);
+        type_count[t]++;
+        if (last_x[s] == COLLIDE_DEAD ||
+            abs(x - last_x[s]) > limit ||
+            abs(slot_y[s] - last_y[s]) > limit) {
+            for (uint8_t c = 0; c < class_count; c++) {
+                if (class_type_a[c] == t || class_type_b[c] == t) {
+                    class_wait[c] = 0;
+                }
+            }
+            last_x[s] = x;
+            last_y[s] = slot_y[s];
+        }
+    }
+
+    for (uint8_t t = 0; t < CT_TYPES; t++) {
+        type_due[t] = false;
+    }
+    for (uint8_t c = 0; c < class_count; c++) {
+        if (class_wait[c] > 0) {
+            class_wait[c]--;
+            class_due[c] = false;
+        } else {
+            class_due[c] = true;
+            class_gap[c] = horizon;
+            type_due[class_type_a[c]] = true;
+            type_due[class_type_b[c]] = true;
+        }
+    }
+
+    for (uint8_t s = 0; s < COLLIDE_SLOTS; s++) {
+        sort_x[s] = type_due[slot_type[s]] ? slot_x[s] : COLLIDE_DEAD;
+    }
+}
+
+/**
+ * After a full sweep, put each due class to sleep for as many frames as
+ * its closest pair needs to close the gap at full speed
+ */
+static void reschedule_classes(void)
+{
+    for (uint8_t c = 0; c < class_count; c++) {
+        if (!class_due[c]) continue;
+
+        uint8_t ta = class_type_a[c];
+        uint8_t tb = class_type_b[c];
+        int16_t gap = class_gap[c] - reach[ta][tb];
+        if (gap <= 0 || type_count[ta] == 0 || type_count[tb] == 0) {
+            // Touching, or nothing to measure against yet: check every frame
+            class_wait[c] = 0;
+            continue;
+        }
+
+        uint8_t wait = gap / (max_speed[ta] + max_speed[tb]);
+        class_wait[c] = (wait > MAX_WAIT) ? MAX_WAIT : wait;
+    }
+}
+
+/**
+ * Narrow one axis of the part of a path that lies inside a box, as the
+ * fraction lo_n/lo_d .. hi_n/hi_d of the way along it
+ * @return false if the path misses the box's extent on this axis
+ */
+static bool clip_axis(int16_t p, int16_t d, int16_t r,
+                      int16_t *lo_n, int16_t *lo_d,
+                      int16_t *hi_n, int16_t *hi_d)
+{
+    if (d == 0) {
+        return p > -r && p < r;
+    }
+
+    // Fractions of the path where it enters and leaves -r < p < r
+    int16_t enter = (d > 0) ? -r - p : p - r;
+    int16_t leave = (d > 0) ? r - p : p + r;
+    int16_t ad = abs(d);
+
+    if (enter * *lo_d > *lo_n * ad) {
+        *lo_n = enter;
+        *lo_d = ad;
+    }
+    if (leave * *hi_d < *hi_n * ad) {
+        *hi_n = leave;
+        *hi_d = ad;
+    }
+    return true;
+}
+
+/**
+ * Swept test for a pair whose end positions are out of reach: did b pass
+ * through a's box on the way here? Both paths run from the last full sweep
+ * to now, so relative to a, b moved along a straight line.
+ */
+static bool path_hits(uint8_t a, uint8_t b, int16_t r)
+{
+    int16_t x1 = slot_x[b] - slot_x[a];
+    int16_t y1 = slot_y[b] - slot_y[a];
+    int16_t x0 = last_x[b] - last_x[a];
+    int16_t y0 = last_y[b] - last_y[a];
+
+    // Both ends beyond the same side of the box: no crossing
+    if ((x0 >= r && x1 >= r) || (x0 <= -r && x1 <= -r) ||
+        (y0 >= r && y1 >= r) || (y0 <= -r && y1 <= -r)) {
+        return false;
+    }
+
+    int16_t lo_n = 0, lo_d = 1;
+    int16_t hi_n = 1, hi_d = 1;
+    if (!clip_axis(x0, x1 - x0, r, &lo_n, &lo_d, &hi_n, &hi_d)) return false;
+    if (!clip_axis(y0, y1 - y0, r, &lo_n, &lo_d, &hi_n, &hi_d)) return false;
+    return lo_n * hi_d < hi_n * lo_d;
+}
+
+void collide_add(uint8_t type, uint8_t index, int16_t cx, int16_t cy)
+{
+    uint8_t s = type_base[type] + index;
+    slot_x[s] = cx;
+    slot_y[s] = cy;
+}
+
+/**
+ * Apply the outcome of one overlapping pair. Either side may already have
+ * died to an earlier hit this frame, so every rule checks both first.
+ */
+static void resolve_hit(uint8_t a, uint8_t b)
+{
+    uint8_t ta = slot_type[a];
+    uint8_t tb = slot_type[b];
+    uint8_t ia = a - type_base[ta];
+    uint8_t ib = b - type_base[tb];
+
+    switch (ta) {
+    case CT_PLAYER:
+        if (tb == CT_FIGHTER) {
+            // Rammed by a fighter
+            if (fighter_live(ib)) {
+                kill_fighter(ib);
+                enemy_score = bcd_add(enemy_score, 0x2);
+            }
+        } else if (tb == CT_EBULLET) {
+            if (ebullet_live(ib)) {
+                kill_ebullet(ib);
+                enemy_score = bcd_add(enemy_score, 0x1);
+            }
+        } else if (tb == CT_POWERUP) {
+            collect_powerup();
+        } else {
+            player_hit_asteroid((AsteroidType)(tb - CT_AST_L), ib);
+        }
+        break;
+
+    case CT_FIGHTER:
+        if (!fighter_live(ia)) break;
+        if (tb == CT_BULLET || tb == CT_SBULLET) {
+            if (tb == CT_BULLET) {
+                if (!bullet_live(ib)) break;
+                kill_bullet(ib);
+            } else if (!sbullet_live(ib)) {
+                break;      // Super bullets carry on through fighters
+            }
+            kill_fighter(ia);
+            player_score = bcd_add(player_score, 0x1);
+            game_score = bcd_add(game_score, bcd_from_u8(game_level));
+        } else if (asteroid_live((AsteroidType)(tb - CT_AST_L), ib)) {
+            // Crashed into a rock: no points
+            damage_asteroid((AsteroidType)(tb - CT_AST_L), ib);
+            kill_fighter(ia);
+        }
+        break;
+
+    case CT_EBULLET:
+        if (ebullet_live(ia) && asteroid_live((AsteroidType)(tb - CT_AST_L), ib)) {
+            damage_asteroid((AsteroidType)(tb - CT_AST_L), ib);
+            kill_ebullet(ia);
+        }
+        break;
+
+    case CT_BULLET:
+        if (!bullet_live(ia)) break;
+        if (tb == CT_BOMBER) {
+            kill_bullet(ia);
+            damage_bomber();
+        } else if (asteroid_live((AsteroidType)(tb - CT_AST_L), ib)) {
+            kill_bullet(ia);
+            if (damage_asteroid((AsteroidType)(tb - CT_AST_L), ib)) {
+                player_score = bcd_add(player_score, asteroid_points[tb - CT_AST_L]);
+            }
+        }
+        break;
+    }
+}
+
+PROFILED void run_collisions(bool player_can_crash)
+{
+    horizon = COLLIDE_REACH_MAX + fx_mul8(COLLIDE_CLOSING_MAX, path_frames);
+    schedule_classes();
+
+    // Insertion sort by x. Entities move a few pixels a frame, so last
+    // frame's order is nearly right and this is close to one pass.
+    for (uint8_t n = 1; n < COLLIDE_SLOTS; n++) {
+        uint8_t s = order[n];
+        int16_t x = sort_x[s];
+        uint8_t m = n;
+        while (m > 0 && sort_x[order[m - 1]] > x) {
+            order[m] = order[m - 1];
+            m--;
+        }
+        order[m] = s;
+    }
+
+    uint8_t live = 0;
+    while (live < COLLIDE_SLOTS && sort_x[order[live]] != COLLIDE_DEAD) {
+        live++;
+    }
+    if (sweep_start >= live) {
+        sweep_start = 0;
+    }
+
+    // Sweep: each entity only looks right, and only within the horizon.
+    // Pairs of due classes are measured; touching ones are hits.
+    uint16_t budget = (path_frames > MAX_PATH_FRAMES) ? UINT16_MAX : COLLIDE_BUDGET;
+    bool cut = false;
+    uint8_t n = sweep_start;
+    hit_count = 0;
+    for (uint8_t done = 0; done < live && !cut; done++, n++) {
+        if (n == live) n = 0;
+        uint8_t a = order[n];
+        int16_t ax = sort_x[a];
+
+        for (uint8_t m = n + 1; m < live; m++) {
+            uint8_t b = order[m];
+            int16_t dx = sort_x[b] - ax;
+            if (dx >= horizon) break;
+
+            uint8_t c = pair_class[slot_type[a]][slot_type[b]];
+            if (c == NO_CLASS || !class_due[c]) continue;
+            if (budget == 0 || hit_count == MAX_HITS) {
+                cut = true;
+                break;
+            }
+            budget--;
+
+            uint8_t ta = slot_type[a];
+            uint8_t tb = slot_type[b];
+            int16_t r = reach[ta][tb];
+            int16_t dy = abs(slot_y[b] - slot_y[a]);
+            int16_t d = (dx > dy) ? dx : dy;
+            if (d < class_gap[c]) class_gap[c] = d;
+            if (d >= r && !((projectile[ta] || projectile[tb]) &&
+                            path_hits(a, b, r))) continue;
+
+            // Slots are grouped by type, so the lower slot has the lower type
+            uint8_t lo = (a < b) ? a : b;
+            uint8_t hi = (a < b) ? b : a;
+            if (lo == SLOT_PLAYER && !player_can_crash &&
+                hi >= SLOT_AST_L && hi < SLOT_POWERUP) continue;
+
+            hit_a[hit_count] = lo;
+            hit_b[hit_count] = hi;
+            hit_count++;
+        }
+    }
+
+    if (cut) {
+        // Out of tests or hit slots: redo this entity first next frame, and
+        // keep every due class due since its closest pair may not have been
+        // seen. Paths keep growing from the last full sweep so the pairs
+        // not reached are still swept over both frames, and the horizon
+        // grows with them.
+        sweep_start = n - 1;
+        path_frames++;
+        for (uint8_t s = 0; s < COLLIDE_SLOTS; s++) {
+            if (slot_x[s] == COLLIDE_DEAD) last_x[s] = COLLIDE_DEAD;
+        }
+    } else {
+        sweep_start = 0;
+        path_frames = 1;
+        reschedule_classes();
+        for (uint8_t s = 0; s < COLLIDE_SLOTS; s++) {
+            last_x[s] = slot_x[s];
+            last_y[s] = slot_y[s];
+        }
+    }
+
+    for (uint8_t h = 0; h < hit_count; h++) {
+        resolve_hit(hit_a[h], hit_b[h]);
+    }
+}
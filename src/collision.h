@@ -0,0 +1,70 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * collision.h - One sweep-and-prune collision pass per frame
+ *
+ * Every module registers the centre of each live entity with collide_add()
+ * as it updates. run_collisions() then sorts all of them by x once, sweeps
+ * for pairs within reach of each other, filters the pairs through a
+ * type-pair interaction table and resolves the hits (kills, damage, score)
+ * through each module's hit functions.
+ *
+ * Two entities hit when both |dx| and |dy| between their centres are less
+ * than the reach the table gives for their types. A reach of 0 means the
+ * types never interact.
+ *
+ * Bullets, enemy bullets and super bullets can step past a small box in a
+ * single frame, so pairs involving one that end out of reach also get a
+ * swept test: the straight path between their relative positions at the
+ * last full sweep and now, clipped against the reach box.
+ *
+ * Each interacting type pair is a class with its own check schedule. The
+ * sweep measures how close the nearest pair of a class came; from that
+ * and the types' top speeds, the class sleeps for the frames it provably
+ * cannot touch, so pairs that are near or closing fast are checked every
+ * frame and distant ones rarely. Types whose classes all sleep skip the
+ * sort. New or teleported entities wake their classes, and a per-frame
+ * test budget spreads a crowded sweep over several frames.
+ */
+
+typedef enum {
+    CT_PLAYER = 0,
+    CT_FIGHTER,
+    CT_EBULLET,
+    CT_BULLET,
+    CT_SBULLET,
+    CT_AST_L,       // Same order as AsteroidType
+    CT_AST_M,
+    CT_AST_S,
+    CT_POWERUP,
+    CT_BOMBER,
+    CT_TYPES
+} collide_type_t;
+
+/**
+ * Set up the slot tables (once, before the first collide_begin())
+ */
+void init_collisions(void);
+
+/**
+ * Forget last frame's entities (call before the frame's updates)
+ */
+void collide_begin(void);
+
+/**
+ * Register a live entity of the given type and pool index at its centre
+ */
+void collide_add(uint8_t type, uint8_t index, int16_t cx, int16_t cy);
+
+/**
+ * Sweep every registered entity and resolve the hits
+ * @param player_can_crash false in demo mode and after game over, when the
+ *        player passes through asteroids
+ */
+void run_collisions(bool player_can_crash);
+
+#endif // COLLISION_H
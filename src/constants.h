@@ -2,6 +2,7 @@
 #define CONSTANTS_H
 
 #include <stdint.h> // for uint8_t, uint16_t, etc.
+#include "bcd.h"
 
 /**
  * constants.h - Consolidated game constants
@@ -12,94 +13,17 @@
 
 
 // XRAM Map Addresses
-
-// 0x0000 - 0xE100 57,600  Pixels  Background      320x180 Bitmap (8bpp)
-
-// Sprite locations
-// 0xE100 - 0xE180 128     Pixels  Spaceship       8x8 (16bpp)
-// 0xE180 - 0xE980 2,048   Pixels  Earth           32x32 (16bpp)
-// 0xE980 - 0xE9A0 32      Pixels  Fighter         4x4 (16bpp)
-// 0xE9A0 - 0xE9A8 8       Pixels  Enemy Bullet    2x2 (16bpp)
-// 0xE9A8 - 0xE9B0 8       Pixels  Player Bullet   2x2 (16bpp)
-// 0xE9B0 - 0xE9D0 32      Pixels  Super Bullet    4x4 (16bpp)
-#define SPACESHIP_DATA  0xE100  //Spaceship Sprite (8x8)
-#define EARTH_DATA      0xE180  //Earth Sprite (32x32)
-#define FIGHTER_DATA    0xE980  //Enemy fighter Sprite (4x4)
-#define EBULLET_DATA    0xE9A0  //Enemy bullet Sprite (2x2)
-#define BULLET_DATA     0xE9A8  //Player bullet Sprite (2x2)
-#define SBULLET_DATA    0xE9B0  //Super bullet Sprite (4x4)
-
-// 0xE9D0 - 0xE9F8 40      Input   Gamepads        4 Pads x 10 bytes
-// 0xE9F8 - 0xEA18 32      Input   Keyboard        256 bits
-// 0xEA18 - 0xEA20 8       Gap     Safety Padding
-#define GAMEPAD_INPUT   0xE9D0 // XRAM address for gamepad data
-#define KEYBOARD_INPUT  0xE9F8  // XRAM address for keyboard data
-
-// 0xEA20 - 0xEA2E 14      Config  Bitmap Config   Plane 0 Setup
-// 0xEA2E - 0xEA36 8       Config  Earth Config    Plane 2 Setup
-// 0xEA36 - 0xEA56 32      Config  Spaceship       Start of Plane 1 Swarm (Affine)
-// 0xEA56 - 0xEA96 64      Config  Asteroid L      2 Sprites (Affine)  
-// 0xEA96 - 0xEB96 256     Config  Fighters        32 sprites (Standard)
-// 0xEB96 - 0xEC16 128     Config  E-Bullets       16 sprites
-// 0xEC16 - 0xEC56 64      Config  P-Bullets       8 sprites
-// 0xEC56 - 0xEC6E 24      Config  S-Bullets       3 sprites
-// 0xEC6E - 0xEC76 8       Config  Powerup         1 sprite
-// 0xEC76 - 0xEC7E 8       Config  Bomber          1 sprite
-// 0xEC7E - 0xEC86 8       Config  Marker          1 sprite
-#define VGA_CONFIG_START 0xEA20         //Start of graphic config addresses (after gamepad and keyboard data)
-extern unsigned BITMAP_CONFIG;          //Bitmap Config 
-extern unsigned SPACECRAFT_CONFIG;      //Spacecraft Sprite Config - Affine 
-extern unsigned EARTH_CONFIG;           //Earth Sprite Config - Standard 
-extern unsigned ASTEROID_L_CONFIG;      //Asteroid L Sprite Config - Affine
-extern unsigned STATION_CONFIG;         //Enemy station sprite config
-extern unsigned BATTLE_CONFIG;          //Enemy battle station sprite config 
-extern unsigned FIGHTER_CONFIG;         //Enemy fighter sprite config
-extern unsigned EBULLET_CONFIG;         //Enemy bullet sprite config
-extern unsigned BULLET_CONFIG;          //Player bullet sprite config
-extern unsigned SBULLET_CONFIG;         //Super bullet sprite config
-extern unsigned POWERUP_CONFIG;         // Powerup sprite config
-extern unsigned BOMBER_CONFIG;          // Bomber Sprite (8x8)
-extern unsigned EXPLOSION_CONFIG;       // Explosion sprite configs
-
-// 0xEC86 - 0xECA6 32      Config  Asteroid M      4 Sprites (Standard)
-// 0xECA6 - 0xECE6 64      Config  Asteroid S      8 Sprites (Standard)
-extern unsigned ASTEROID_L_CONFIG;
-extern unsigned ASTEROID_M_CONFIG;
-extern unsigned ASTEROID_S_CONFIG;
-
-// 0xEC46 - 0xEC56 16      Config  Text Config     Plane 2 Overlay
-// 0xEC56 - 0xED2E 216     Data    Text Buffer     72 chars x 3 bytes
-// 0xED2E - 0xED40 18      Gap     Safety Padding
-extern unsigned TEXT_CONFIG;            //On screen text configs
-extern unsigned text_message_addr;
-
-// 0xEDCE - 0xF000 562     Gap     FreeSpace
-
-// 0xF000 - 0xF200 512     Palette 
-
-// 0xF200 - 0xF300 256     Pixels  Explosion       4x32 Anim Strip
-// 0xF300 - 0xF380 128     Pixels  Powerup         8x8 (16bpp)
-// 0xF380 - 0xF400 128     Pixels  Bomber          8x8 (16bpp)
-// 0xF400 - 0xF480 128     Pixels  Marker          8x8 (16bpp)
-#define EXPLOSION_DATA  0xEE40    // Sprite data for explosion animation (not config data)
-// #define POWERUP_DATA      0xF300  <-- defined in powerup.h
-#define BOMBER_DATA     0xFC80  //Bomber Sprite (8x8)
-#define MARKER_DATA     0xF400
-
-// 0xF480 - 0xFC80 2,048   Pixels  Asteroid M      16x16 (4 frames)  <-- shared with Asteroid_L
-// 0xFC80 - 0xFE80 512     Pixels  Asteroid S      8x8 (4 frames)
-#define ASTEROID_L_DATA   0xF200  // Asteroid L Sprite Data (32x32)
-#define ASTEROID_M_DATA   0xFA00  // Asteroid M Sprite Data (16x16)
-#define ASTEROID_S_DATA   0xFC00  // Asteroid S Sprite Data (8x8)
-
-// 0xFE80 - 0xFFC0 320     Gap     Space  Room for ~2 more 16x16 sprites
-// 0xFFC0 - 0xFFFF 64      Config  Sound (PSG) Safety Anchor
-#define PSG_XRAM_ADDR   0xFFC0    // PSG memory location (must match sound.c)
+//
+// Every XRAM address (sprite art, input devices, the config block and each
+// *_CONFIG inside it, text plane, palette and PSG) is generated from
+// src/xram_map.txt by tools/gen_xram_map.py. The generated header lists the
+// resulting layout, including the free space left.
+#include "xram_map.h"
 
 // Global frame counter (from rpmegafighter.c)
 extern uint16_t game_frame;
-extern int16_t player_score;
-extern int16_t enemy_score;
+extern bcd_t player_score;     // Packed BCD (bcd.h)
+extern bcd_t enemy_score;
 
 
 // Explosion management
@@ -113,15 +37,17 @@ extern int16_t enemy_score;
 
 
 // Player ship properties
-#define SHIP_ROTATION_STEPS 24  // Number of rotation steps
-#define SHIP_ROTATION_MAX   23  // Ship rotation constant (24 rotation steps, 0-23)
-#define SHIP_ROT_SPEED      3   // Frames per rotation step
+#define SHIP_ROTATION_STEPS 32  // Number of rotation steps (a power of two)
+#define SHIP_ROTATION_MASK  (SHIP_ROTATION_STEPS - 1)   // Wraps a step
+#define SHIP_ROT_SPEED      2   // Frames per rotation step
 #define BOUNDARY_X          100 // Horizontal boundary for player movement
 #define BOUNDARY_Y          60  // Vertical boundary for player movement
+#define PLAYER_VEL_FRAC     9   // Velocity fraction bits (fixed.h)
 
 // Bullet properties
 #define MAX_BULLETS         8
 #define BULLET_COOLDOWN     8
+#define BULLET_VEL_FRAC     6   // Velocity fraction bits, enemy bullets too
 
 // Enemy bullet properties
 #define MAX_EBULLETS        10       // Enemy bullets
@@ -139,9 +65,10 @@ extern int16_t enemy_score;
 #define INITIAL_FIGHTER_SPEED_MAX 256 // Initial maximum fighter speed
 #define FIGHTER_SPEED_INCREASE    32  // Fighter speed increase per level
 #define MAX_FIGHTER_SPEED         512 // Maximum cap on fighter speed
+#define FIGHTER_VEL_FRAC          8   // Velocity fraction bits (Q8.8)
 
 // Scoring
-#define SCORE_TO_WIN        100
+#define SCORE_TO_WIN        0x100   // Packed BCD: 100
 // #define SCORE_BASIC_KILL    1
 // #define SCORE_MINE_KILL     5
 // #define SCORE_SHIELD_KILL   5
@@ -234,4 +161,12 @@ extern int16_t enemy_score;
 // Demo configuration
 #define DEMO_DURATION_FRAMES (60 * 40) // Frames for demo mode (40 seconds)
 
+// Gameplay loop calls timed by tools/profile6502.py. A PROFILE build keeps
+// them out of line so LTO cannot fold them into main() and lose the symbol.
+#ifdef PROFILE
+#define PROFILED __attribute__((noinline))
+#else
+#define PROFILED
+#endif
+
 #endif // CONSTANTS_H
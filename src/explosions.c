@@ -2,22 +2,37 @@
 #include "constants.h" // EXPLOSION_DATA
 #include "player.h" // scroll_x, scroll_y, random
 #include "random.h"
+#include "xram_stats.h"
+#include "sprite_shadow.h"
+#include "pool.h"
+#include "fixed.h"
 #include <rp6502.h>
 #include <stdlib.h>
 
-explosion_t explosions[MAX_EXPLOSIONS];
-extern unsigned EXPLOSION_CONFIG;
+// Particles, one array per field
+static int16_t explosion_x[MAX_EXPLOSIONS];
+static int16_t explosion_y[MAX_EXPLOSIONS];
+static int8_t explosion_vx[MAX_EXPLOSIONS];     // Q4.4 pixels per frame
+static int8_t explosion_vy[MAX_EXPLOSIONS];
+static uint8_t explosion_vx_rem[MAX_EXPLOSIONS];
+static uint8_t explosion_vy_rem[MAX_EXPLOSIONS];
+static uint8_t explosion_frame[MAX_EXPLOSIONS];
+static uint8_t explosion_timer[MAX_EXPLOSIONS];
+POOL(explosion_pool, MAX_EXPLOSIONS);
+
+// Last config values written to XRAM for each sprite
+static sprite_shadow_t explosion_shadow[MAX_EXPLOSIONS];
 
 // ---------------------------------------------------------
 // INIT
 // ---------------------------------------------------------
 void init_explosions(void) {
     size_t size = sizeof(vga_mode4_sprite_t);
-    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
-        explosions[i].active = false;
-        
+    sprite_shadow_reset(explosion_shadow, MAX_EXPLOSIONS);
+    pool_reset(&explosion_pool);
+    for (uint8_t i = 0; i < MAX_EXPLOSIONS; i++) {
         unsigned ptr = EXPLOSION_CONFIG + (i * size);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        sprite_hide(ptr, &explosion_shadow[i]);
     }
 }
 
@@ -25,44 +40,40 @@ void init_explosions(void) {
 // SPAWN
 // ---------------------------------------------------------
 void start_explosion(int16_t x, int16_t y) {
-    int particles_spawned = 0;
     size_t size = sizeof(vga_mode4_sprite_t);
+    XRAM_OWNER_SAVE(XS_EXPLOSIONS);
     
     // Try to spawn 4 particles for a nice cluster
-    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
-        if (!explosions[i].active) {
-            explosions[i].active = true;
-            
-            // Random scatter (-4 to +4 pixels)
-            explosions[i].x = x + (int16_t)random(0, 8) - 4;
-            explosions[i].y = y + (int16_t)random(0, 8) - 4;
-            
-            // Random Velocity (Explode outward)
-            explosions[i].vx = (rand16() & 1) ? random(10, 40) : -random(10, 40);
-            explosions[i].vy = (rand16() & 1) ? random(10, 40) : -random(10, 40);
-            
-            // Start at frame 2 (skip the "ship" frames 0/1)
-            explosions[i].frame = 2; 
-            explosions[i].timer = 0;
+    for (uint8_t n = 0; n < 4; n++) {
+        uint8_t i = pool_alloc(&explosion_pool);
+        if (i == POOL_NONE) break;
 
-            // --- CONFIG (Standard Sprite) ---
-            unsigned ptr = EXPLOSION_CONFIG + (i * size);
-            
-            // Calculate offset: 4x4 sprite = 16 pixels * 2 bytes = 32 bytes per frame
-            uint16_t offset = 2 * 32; 
+        // Random scatter (-4 to +4 pixels)
+        explosion_x[i] = x + (int16_t)random(0, 8) - 4;
+        explosion_y[i] = y + (int16_t)random(0, 8) - 4;
+        
+        // Random Velocity (Explode outward, 1 to 3 pixels per frame)
+        explosion_vx[i] = (rand16() & 1) ? random(16, 48) : -random(16, 48);
+        explosion_vy[i] = (rand16() & 1) ? random(16, 48) : -random(16, 48);
+        explosion_vx_rem[i] = 0;
+        explosion_vy_rem[i] = 0;
+        
+        // Start at frame 2 (skip the "ship" frames 0/1)
+        explosion_frame[i] = 2; 
+        explosion_timer[i] = 0;
 
-            xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr,(uint16_t)(EXPLOSION_DATA + offset));
-            xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 2); // 4x4
-            xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
-            
-            // Note: Position is set in update loop, or can set here initially
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, explosions[i].x);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, explosions[i].y);
+        // --- CONFIG (Standard Sprite) ---
+        unsigned ptr = EXPLOSION_CONFIG + (i * size);
+        
+        // Calculate offset: 4x4 sprite = 16 pixels * 2 bytes = 32 bytes per frame
+        uint16_t offset = 2 * 32; 
 
-            particles_spawned++;
-            if (particles_spawned >= 4) break; 
-        }
+        sprite_image(ptr, &explosion_shadow[i], (uint16_t)(EXPLOSION_DATA + offset), 2); // 4x4
+        
+        // Note: Position is set in update loop, or can set here initially
+        sprite_move(ptr, &explosion_shadow[i], explosion_x[i], explosion_y[i]);
     }
+    XRAM_OWNER_RESTORE();
 }
 
 // ---------------------------------------------------------
@@ -71,41 +82,44 @@ void start_explosion(int16_t x, int16_t y) {
 void update_explosions(void) {
     size_t size = sizeof(vga_mode4_sprite_t);
 
-    for (int i = 0; i < MAX_EXPLOSIONS; i++) {
-        if (!explosions[i].active) continue;
+    // Live particles only, backwards so finishing one is safe
+    for (uint8_t k = explosion_pool.count; k-- > 0; ) {
+        uint8_t i = explosion_pool.slot[k];
 
-        // Move (Simple integer math for particles)
-        // Divide by 10 to slow down the subpixel velocity
-        explosions[i].x += (explosions[i].vx / 10); 
-        explosions[i].y += (explosions[i].vy / 10);
+        // Move, carrying the sub-pixel fraction
+        explosion_x[i] += fx_step8(explosion_vx[i], &explosion_vx_rem[i], EXPLOSION_VEL_FRAC);
+        explosion_y[i] += fx_step8(explosion_vy[i], &explosion_vy_rem[i], EXPLOSION_VEL_FRAC);
 
         // Animation Timer
-        explosions[i].timer++;
-        if (explosions[i].timer > 4) { // Change frame every 4 ticks
-            explosions[i].timer = 0;
-            explosions[i].frame++;
+        explosion_timer[i]++;
+        if (explosion_timer[i] > 4) { // Change frame every 4 ticks
+            explosion_timer[i] = 0;
+            explosion_frame[i]++;
             
             // Asset has 8 frames total (0-7). We use 2-7.
-            if (explosions[i].frame >= 8) {
+            if (explosion_frame[i] >= 8) {
                 // Done
-                explosions[i].active = false;
+                pool_free(&explosion_pool, i);
                 unsigned ptr = EXPLOSION_CONFIG + (i * size);
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+                sprite_hide(ptr, &explosion_shadow[i]);
                 continue;
             }
             
             // Update Pointer
             unsigned ptr = EXPLOSION_CONFIG + (i * size);
-            uint16_t offset = explosions[i].frame * 32; 
-            xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, (uint16_t)(EXPLOSION_DATA + offset));
+            uint16_t offset = explosion_frame[i] * 32; 
+            sprite_image(ptr, &explosion_shadow[i], (uint16_t)(EXPLOSION_DATA + offset), 2);
         }
 
         // Render
-        explosions[i].x -= scroll_dx;
-        explosions[i].y -= scroll_dy;
+        explosion_x[i] -= scroll_dx;
+        explosion_y[i] -= scroll_dy;
         
         unsigned ptr = EXPLOSION_CONFIG + (i * size);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, explosions[i].x);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, explosions[i].y);
+        sprite_move(ptr, &explosion_shadow[i], explosion_x[i], explosion_y[i]);
     }
 }
+
+uint8_t explosion_count(void) {
+    return explosion_pool.count;
+}
@@ -4,18 +4,14 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-typedef struct {
-    bool active;
-    int16_t x, y;
-    int16_t vx, vy;
-    uint8_t frame;
-    uint8_t timer;
-} explosion_t;
-
 #define MAX_EXPLOSIONS 16
+#define EXPLOSION_VEL_FRAC 4    // Particle velocity fraction bits (Q4.4)
 
 void init_explosions(void);
 void update_explosions(void);
 void start_explosion(int16_t x, int16_t y);
 
+// Particles currently live
+uint8_t explosion_count(void);
+
 #endif
\ No newline at end of file
@@ -9,36 +9,17 @@
 #include <stdio.h>
 #include "powerup.h"
 #include "asteroids.h"
+#include "sprite_shadow.h"
+#include "collision.h"
+#include "pool.h"
+#include "heading.h"
+#include "trig_tables.h"
+#include "fixed.h"
 
 // ============================================================================
 // CONSTANTS
 // ============================================================================
 
-
-// ============================================================================
-// TYPES
-// ============================================================================
-
-typedef struct {
-    int16_t x, y;
-    int16_t status;
-    int16_t vx_rem, vy_rem;
-} Bullet;
-
-typedef struct {
-    int16_t x, y;
-    int16_t vx, vy;
-    int16_t vx_i, vy_i;
-    int16_t vx_rem, vy_rem;
-    int16_t status;
-    int16_t dx, dy;
-    int16_t frame;
-    int16_t lx1, ly1;
-    int16_t lx2, ly2;
-    int16_t anim_timer;
-    bool is_exploding;
-} Fighter;
-
 // ============================================================================
 // EXTERNAL DEPENDENCIES
 // ============================================================================
@@ -47,20 +28,10 @@ typedef struct {
 extern int16_t player_x, player_y;
 extern int16_t player_vx_applied, player_vy_applied;
 extern int16_t scroll_dx, scroll_dy;
-extern int16_t enemy_score;
 extern int16_t game_level;
 // extern uint16_t game_frame;
 
-// Sprite configuration addresses
-extern unsigned FIGHTER_CONFIG;
-extern unsigned EBULLET_CONFIG;
-
 // Lookup tables from definitions.h
-extern const int16_t sin_fix[25];
-extern const int16_t cos_fix[25];
-
-// Asteroid collision check
-extern bool check_asteroid_hit_fighter(int16_t fx, int16_t fy);
 
 // Fighter World Boundaries
 #define FWORLD_PAD 100  // Extra padding beyond screen edges
@@ -80,14 +51,44 @@ extern void play_sound(uint8_t type, uint16_t frequency, uint8_t waveform,
 // MODULE STATE
 // ============================================================================
 
-static Bullet ebullets[MAX_EBULLETS];
+// Enemy bullets, one array per field
+static int16_t ebullet_x[MAX_EBULLETS];
+static int16_t ebullet_y[MAX_EBULLETS];
+static int8_t ebullet_status[MAX_EBULLETS];     // -1 = inactive, else direction
+static uint8_t ebullet_vx_rem[MAX_EBULLETS];    // Sub-pixel remainders, 0-63
+static uint8_t ebullet_vy_rem[MAX_EBULLETS];
 static uint16_t ebullet_cooldown = 0;
 static uint16_t max_ebullet_cooldown = INITIAL_EBULLET_COOLDOWN;
 static uint8_t current_ebullet_index = 0;
 
-static Fighter fighters[MAX_FIGHTERS];
+// Fighters, one array per field
+static int16_t fighter_x[MAX_FIGHTERS];
+static int16_t fighter_y[MAX_FIGHTERS];
+static int16_t fighter_vx[MAX_FIGHTERS];        // Current velocity (1/256 px)
+static int16_t fighter_vy[MAX_FIGHTERS];
+static int16_t fighter_vx_i[MAX_FIGHTERS];      // Speed picked at spawn
+static int16_t fighter_vy_i[MAX_FIGHTERS];
+static uint8_t fighter_vx_rem[MAX_FIGHTERS];    // Sub-pixel remainders, 0-255
+static uint8_t fighter_vy_rem[MAX_FIGHTERS];
+static int8_t fighter_status[MAX_FIGHTERS];     // 0 dead, 1 ready, >1 reloading
+static uint8_t fighter_anim_timer[MAX_FIGHTERS];
+static bool fighter_exploding[MAX_FIGHTERS];
 int16_t active_fighter_count = 0;  // Non-static, may be used externally
 
+// Live fighters are flying or still exploding; free ones wait to respawn
+POOL(fighter_pool, MAX_FIGHTERS);
+
+// Every dead fighter comes back FIGHTER_SPAWN_RATE frames after it died, so
+// the respawn times queue up in order of death
+static uint16_t fighter_clock = 0;
+static uint16_t respawn_due[MAX_FIGHTERS];
+static uint8_t respawn_head = 0;
+static uint8_t respawn_count = 0;
+
+// Last config values written to XRAM for each sprite
+static sprite_shadow_t fighter_shadow[MAX_FIGHTERS];
+static sprite_shadow_t ebullet_shadow[MAX_EBULLETS];
+
 // Fighter speed parameters (increase with level)
 static int16_t fighter_speed_min = INITIAL_FIGHTER_SPEED_MIN;
 static int16_t fighter_speed_max = INITIAL_FIGHTER_SPEED_MAX;
@@ -110,85 +111,134 @@ void set_fighter_frame(uint8_t fighter_idx, uint8_t frame_idx) {
 
     // 3. Update the pointer in XRAM
     //    We only change where this specific sprite looks for pixels
-    xram0_struct_set(sprite_config_ptr, vga_mode4_sprite_t, xram_sprite_ptr, image_data_ptr);
+    sprite_image(sprite_config_ptr, &fighter_shadow[fighter_idx], image_data_ptr, 2); // 4x4
 }
 
 
 void init_fighters(void)
 {
+    sprite_shadow_reset(fighter_shadow, MAX_FIGHTERS);
+    sprite_shadow_reset(ebullet_shadow, MAX_EBULLETS);
+
     for (uint8_t i = 0; i < MAX_FIGHTERS; i++) {
-        fighters[i].vx_i = random(fighter_speed_min, fighter_speed_max);
-        fighters[i].vy_i = random(fighter_speed_min, fighter_speed_max);
-        fighters[i].vx = 0;
-        fighters[i].vy = 0;
-        fighters[i].status = 1;
-        fighters[i].is_exploding = false; // Not exploding at start
-        fighters[i].anim_timer = 0; // Initialize animation timer
+        fighter_vx_i[i] = random(fighter_speed_min, fighter_speed_max);
+        fighter_vy_i[i] = random(fighter_speed_min, fighter_speed_max);
+        fighter_vx[i] = 0;
+        fighter_vy[i] = 0;
+        fighter_status[i] = 1;
+        fighter_exploding[i] = false; // Not exploding at start
+        fighter_anim_timer[i] = 0; // Initialize animation timer
         set_fighter_frame(i, 0); // Points back to the first image in the sheet (Normal ship)
 
         uint8_t edge = random(0, 4);  // 0=right, 1=left, 2=top, 3=bottom
                 
         if (edge == 0) {
             // Spawn on right edge
-            fighters[i].x = SCREEN_WIDTH + random(FWORLD_PAD_D2, FWORLD_PAD);
-            fighters[i].y = random(20, SCREEN_HEIGHT - 20);
+            fighter_x[i] = SCREEN_WIDTH + random(FWORLD_PAD_D2, FWORLD_PAD);
+            fighter_y[i] = random(20, SCREEN_HEIGHT - 20);
         } else if (edge == 1) {
             // Spawn on left edge
-            fighters[i].x = -random(FWORLD_PAD_D2, FWORLD_PAD);
-            fighters[i].y = random(20, SCREEN_HEIGHT - 20);
+            fighter_x[i] = -random(FWORLD_PAD_D2, FWORLD_PAD);
+            fighter_y[i] = random(20, SCREEN_HEIGHT - 20);
         } else if (edge == 2) {
             // Spawn on top edge
-            fighters[i].x = random(20, SCREEN_WIDTH - 20);
-            fighters[i].y = SCREEN_HEIGHT + random(FWORLD_PAD_D2, FWORLD_PAD);
+            fighter_x[i] = random(20, SCREEN_WIDTH - 20);
+            fighter_y[i] = SCREEN_HEIGHT + random(FWORLD_PAD_D2, FWORLD_PAD);
         } else {
             // Spawn on bottom edge
-            fighters[i].x = random(20, SCREEN_WIDTH - 20);
-            fighters[i].y = -random(FWORLD_PAD_D2, FWORLD_PAD);
+            fighter_x[i] = random(20, SCREEN_WIDTH - 20);
+            fighter_y[i] = -random(FWORLD_PAD_D2, FWORLD_PAD);
         }
         
-        fighters[i].vx_rem = 0;
-        fighters[i].vy_rem = 0;
-        fighters[i].dx = 0;
-        fighters[i].dy = 0;
-        fighters[i].frame = random(0, 1);
+        fighter_vx_rem[i] = 0;
+        fighter_vy_rem[i] = 0;
     }
     active_fighter_count = MAX_FIGHTERS;
+
+    pool_reset(&fighter_pool);
+    while (pool_alloc(&fighter_pool) != POOL_NONE) {}
+    respawn_head = 0;
+    respawn_count = 0;
     
     // Initialize ebullets
     for (uint8_t i = 0; i < MAX_EBULLETS; i++) {
-        ebullets[i].status = -1;
-        ebullets[i].x = 0;
-        ebullets[i].y = 0;
-        ebullets[i].vx_rem = 0;
-        ebullets[i].vy_rem = 0;
+        ebullet_status[i] = -1;
+        ebullet_x[i] = 0;
+        ebullet_y[i] = 0;
+        ebullet_vx_rem[i] = 0;
+        ebullet_vy_rem[i] = 0;
     }
 }
 
-void update_fighters(void)
+/**
+ * Bring a dead fighter back in from a random edge of the world
+ */
+static void respawn_fighter(uint8_t i)
+{
+    fighter_vx_i[i] = random(fighter_speed_min, fighter_speed_max);
+    fighter_vy_i[i] = random(fighter_speed_min, fighter_speed_max);
+    
+    uint8_t edge = random(0, 4);  // 0=right, 1=left, 2=top, 3=bottom
+    
+    if (edge == 0) {
+        // Spawn on right edge
+        fighter_x[i] = SCREEN_WIDTH + random(FWORLD_PAD_D2, FWORLD_PAD);
+        fighter_y[i] = random(20, SCREEN_HEIGHT - 20);
+    } else if (edge == 1) {
+        // Spawn on left edge
+        fighter_x[i] = -random(FWORLD_PAD_D2, FWORLD_PAD);
+        fighter_y[i] = random(20, SCREEN_HEIGHT - 20);
+    } else if (edge == 2) {
+        // Spawn on top edge
+        fighter_x[i] = random(20, SCREEN_WIDTH - 20);
+        fighter_y[i] = SCREEN_HEIGHT + random(FWORLD_PAD_D2, FWORLD_PAD);
+    } else {
+        // Spawn on bottom edge
+        fighter_x[i] = random(20, SCREEN_WIDTH - 20);
+        fighter_y[i] = -random(FWORLD_PAD_D2, FWORLD_PAD);
+    }
+    
+    fighter_status[i] = 1;
+    fighter_exploding[i] = false; // Reset exploding state
+    fighter_anim_timer[i] = 0; // Initialize animation timer
+    set_fighter_frame(i, 0); // Points back to the first image in the sheet (Normal ship)
+    active_fighter_count++;
+}
+
+PROFILED void update_fighters(void)
 {
     int16_t fvx_applied, fvy_applied;
     
     int16_t player_world_x = player_x;
     int16_t player_world_y = player_y;
 
-    // for (uint8_t i = 0; i < 1; i++) {
-    //     printf("Fighter %d position 1: x=%d, y=%d\n", i, fighters[i].x, fighters[i].y);
-    //     printf(fighters[i].status ? "active\n" : "inactive\n");
-    // }
+    // Respawns that are due, oldest death first. A fighter's explosion is
+    // long over by then, so a free slot is always waiting.
+    fighter_clock++;
+    while (respawn_count > 0 &&
+           (int16_t)(fighter_clock - respawn_due[respawn_head]) >= 0) {
+        uint8_t i = pool_alloc(&fighter_pool);
+        if (i == POOL_NONE) break;
+        respawn_fighter(i);
+        respawn_head = (respawn_head + 1) % MAX_FIGHTERS;
+        respawn_count--;
+    }
 
-    for (uint8_t i = 0; i < MAX_FIGHTERS; i++) {
+    // Live fighters only, backwards so retiring one is safe
+    for (uint8_t k = fighter_pool.count; k-- > 0; ) {
+        uint8_t i = fighter_pool.slot[k];
 
-        if (fighters[i].is_exploding) {
-            fighters[i].anim_timer++;
+        if (fighter_exploding[i]) {
+            fighter_anim_timer[i]++;
     
             // Slow down animation (e.g., change frame every 4 ticks)
-            uint8_t current_frame = fighters[i].anim_timer / 4;
+            uint8_t current_frame = fighter_anim_timer[i] / 4;
             
             if (current_frame < 8) {
                 set_fighter_frame(i, current_frame);
             } else {
                 // Animation done, kill fighter or respawn
-                fighters[i].is_exploding = false;
+                fighter_exploding[i] = false;
             }
 
             if (current_frame == 8 && !powerup.active) {
@@ -196,132 +246,80 @@ void update_fighters(void)
                 if (drop_chance < POWERUP_DROP_CHANCE_PERCENT) {
                     powerup.active = true;
                     powerup.timer = POWERUP_DURATION_FRAMES;
-                    powerup.x = fighters[i].x;
-                    powerup.y = fighters[i].y;
+                    powerup.x = fighter_x[i];
+                    powerup.y = fighter_y[i];
                 }
             }
 
         }
 
-        if (fighters[i].status <= 0) {
-            fighters[i].status--;
-            if (fighters[i].status <= -FIGHTER_SPAWN_RATE) {
-                fighters[i].vx_i = random(fighter_speed_min, fighter_speed_max);
-                fighters[i].vy_i = random(fighter_speed_min, fighter_speed_max);
-                
-                uint8_t edge = random(0, 4);  // 0=right, 1=left, 2=top, 3=bottom
-                
-                if (edge == 0) {
-                    // Spawn on right edge
-                    fighters[i].x = SCREEN_WIDTH + random(FWORLD_PAD_D2, FWORLD_PAD);
-                    fighters[i].y = random(20, SCREEN_HEIGHT - 20);
-                } else if (edge == 1) {
-                    // Spawn on left edge
-                    fighters[i].x = -random(FWORLD_PAD_D2, FWORLD_PAD);
-                    fighters[i].y = random(20, SCREEN_HEIGHT - 20);
-                } else if (edge == 2) {
-                    // Spawn on top edge
-                    fighters[i].x = random(20, SCREEN_WIDTH - 20);
-                    fighters[i].y = SCREEN_HEIGHT + random(FWORLD_PAD_D2, FWORLD_PAD);
-                } else {
-                    // Spawn on bottom edge
-                    fighters[i].x = random(20, SCREEN_WIDTH - 20);
-                    fighters[i].y = -random(FWORLD_PAD_D2, FWORLD_PAD);
-                }
-                
-                fighters[i].status = 1;
-                fighters[i].is_exploding = false; // Reset exploding state
-                fighters[i].anim_timer = 0; // Initialize animation timer
-                set_fighter_frame(i, 0); // Points back to the first image in the sheet (Normal ship)
-                active_fighter_count++;
+        if (fighter_status[i] <= 0) {
+            if (fighter_exploding[i]) {
+                fighter_x[i] -= scroll_dx;
+                fighter_y[i] -= scroll_dy;
+            } else {
+                // Explosion over: hide it until its respawn comes up
+                unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
+                sprite_hide(ptr, &fighter_shadow[i]);
+                pool_free(&fighter_pool, i);
             }
-            if (fighters[i].is_exploding) {
-                fighters[i].x -= scroll_dx;
-                fighters[i].y -= scroll_dy;
-            } 
             continue;
         }
 
-        fighters[i].x -= scroll_dx;
-        fighters[i].y -= scroll_dy;
+        fighter_x[i] -= scroll_dx;
+        fighter_y[i] -= scroll_dy;
 
-        if (fighters[i].x + 4 > player_x && fighters[i].x < player_x + 8 &&
-            fighters[i].y + 4 > player_y && fighters[i].y < player_y + 8) {
-            fighters[i].status = 0;
-            active_fighter_count--;
-            enemy_score += 2;
-            fighters[i].is_exploding = true; // Start explosion sequence
-            continue;
-        }
-
-        // Inside update_fighters
-        if ((i % 4) == (game_frame % 4)) { 
-            if (check_asteroid_hit_fighter(fighters[i].x, fighters[i].y)) {
-                fighters[i].status = 0;
-                active_fighter_count--;
-                // enemy_score += 2;
-                fighters[i].is_exploding = true; // Start explosion sequence
-                continue;
-                // Do not give player points? Or give points for "Environment Kill"?
-            }
-        }
-        
         if (game_frame == 0) {
-            int16_t fdx = player_world_x - fighters[i].x;
-            int16_t fdy = player_world_y - fighters[i].y;
+            int16_t fdx = player_world_x - fighter_x[i];
+            int16_t fdy = player_world_y - fighter_y[i];
             
             if (fdx > 0) {
-                fighters[i].vx = fighters[i].vx_i;
+                fighter_vx[i] = fighter_vx_i[i];
             } else if (fdx < 0) {
-                fighters[i].vx = -fighters[i].vx_i;
+                fighter_vx[i] = -fighter_vx_i[i];
             } else {
-                fighters[i].vx = 0;
+                fighter_vx[i] = 0;
             }
             
             if (fdy > 0) {
-                fighters[i].vy = fighters[i].vy_i;
+                fighter_vy[i] = fighter_vy_i[i];
             } else if (fdy < 0) {
-                fighters[i].vy = -fighters[i].vy_i;
+                fighter_vy[i] = -fighter_vy_i[i];
             } else {
-                fighters[i].vy = 0;
+                fighter_vy[i] = 0;
             }
         }
         
-        fvx_applied = (fighters[i].vx + fighters[i].vx_rem) >> 8;
-        fvy_applied = (fighters[i].vy + fighters[i].vy_rem) >> 8;
-        
-        fighters[i].vx_rem = fighters[i].vx + fighters[i].vx_rem - (fvx_applied << 8);
-        fighters[i].vy_rem = fighters[i].vy + fighters[i].vy_rem - (fvy_applied << 8);
-        
-        fighters[i].dx = fvx_applied;
-        fighters[i].dy = fvy_applied;
+        fvx_applied = fx_step8(fighter_vx[i], &fighter_vx_rem[i], FIGHTER_VEL_FRAC);
+        fvy_applied = fx_step8(fighter_vy[i], &fighter_vy_rem[i], FIGHTER_VEL_FRAC);
         
-        fighters[i].x += fvx_applied;
-        fighters[i].y += fvy_applied;
+        fighter_x[i] += fvx_applied;
+        fighter_y[i] += fvy_applied;
 
-        // if (fighters[i].x > FIGHTER_WORLD_X2) {
-        //     fighters[i].x -= FIGHTER_WORLD_X;
-        // } else if (fighters[i].x < -FIGHTER_WORLD_X2) {
-        //     fighters[i].x += FIGHTER_WORLD_X;
+        // if (fighter_x[i] > FIGHTER_WORLD_X2) {
+        //     fighter_x[i] -= FIGHTER_WORLD_X;
+        // } else if (fighter_x[i] < -FIGHTER_WORLD_X2) {
+        //     fighter_x[i] += FIGHTER_WORLD_X;
         // }
 
-        // if (fighters[i].y > FIGHTER_WORLD_Y2) {
-        //     fighters[i].y -= FIGHTER_WORLD_Y;
-        // } else if (fighters[i].y < -FIGHTER_WORLD_Y2) {
-        //     fighters[i].y += FIGHTER_WORLD_Y;
+        // if (fighter_y[i] > FIGHTER_WORLD_Y2) {
+        //     fighter_y[i] -= FIGHTER_WORLD_Y;
+        // } else if (fighter_y[i] < -FIGHTER_WORLD_Y2) {
+        //     fighter_y[i] += FIGHTER_WORLD_Y;
         // }
-        if (fighters[i].x < FWORLD_X1) fighters[i].x += FWORLD_X; else if (fighters[i].x > FWORLD_X2) fighters[i].x -= FWORLD_X;
-        if (fighters[i].y < FWORLD_Y1) fighters[i].y += FWORLD_Y; else if (fighters[i].y > FWORLD_Y2) fighters[i].y -= FWORLD_Y;
+        if (fighter_x[i] < FWORLD_X1) fighter_x[i] += FWORLD_X; else if (fighter_x[i] > FWORLD_X2) fighter_x[i] -= FWORLD_X;
+        if (fighter_y[i] < FWORLD_Y1) fighter_y[i] += FWORLD_Y; else if (fighter_y[i] > FWORLD_Y2) fighter_y[i] -= FWORLD_Y;
 
+        collide_add(CT_FIGHTER, i, fighter_x[i] + 2, fighter_y[i] + 2);
     }
 
     // for (uint8_t i = 0; i < 1; i++) {
-    //     printf("Fighter %d position 2: x=%d, y=%d\n", i, fighters[i].x, fighters[i].y);
-    //     printf(fighters[i].status ? "active\n" : "inactive\n");
+    //     printf("Fighter %d position 2: x=%d, y=%d\n", i, fighter_x[i], fighter_y[i]);
+    //     printf(fighter_status[i] ? "active\n" : "inactive\n");
     // }
 }
 
-void fire_ebullet(void)
+PROFILED void fire_ebullet(void)
 {
     if (ebullet_cooldown > 0) { //Global Fighter fire cooldown
         return;
@@ -330,51 +328,42 @@ void fire_ebullet(void)
     // ebullet_cooldown = max_ebullet_cooldown;
     ebullet_cooldown = NEBULLET_TIMER_MAX;
     
-    if (ebullets[current_ebullet_index].status < 0) {
-        for (uint8_t i = 0; i < MAX_FIGHTERS; i++) {
-            if (fighters[i].status == 1) {  // A single ship is ready to fire
+    if (ebullet_status[current_ebullet_index] < 0) {
+        for (uint8_t k = fighter_pool.count; k-- > 0; ) {
+            uint8_t i = fighter_pool.slot[k];
+            if (fighter_status[i] == 1) {  // A single ship is ready to fire
 
-                if (fighters[i].x > 0 && fighters[i].x < SCREEN_WIDTH - 4 &&
-                    fighters[i].y > 0 && fighters[i].y < SCREEN_HEIGHT - 4) {
+                if (fighter_x[i] > 0 && fighter_x[i] < SCREEN_WIDTH - 4 &&
+                    fighter_y[i] > 0 && fighter_y[i] < SCREEN_HEIGHT - 4) {
 
-                    int16_t fdx = player_x - fighters[i].x;
-                    int16_t fdy = -(player_y - fighters[i].y);
+                    int16_t fdx = player_x - fighter_x[i];
+                    int16_t fdy = -(player_y - fighter_y[i]);
                     int16_t distance = abs(fdx) + abs(fdy);
                     
                     if (distance > 0) {
-                        int16_t tti_frames = distance / 4;
+                        // Both on screen, so at most 125 frames; the
+                        // player moves at most a few pixels per frame
+                        uint8_t tti_frames = distance >> 2;
                         if (tti_frames == 0) tti_frames = 1;
                         
-                        int16_t pre_player_x = player_x + 4 + (player_vx_applied * tti_frames);
-                        int16_t pre_player_y = player_y + 4 + (player_vy_applied * tti_frames);
+                        int16_t pre_player_x = player_x + 4 + fx_mul8s(player_vx_applied, tti_frames);
+                        int16_t pre_player_y = player_y + 4 + fx_mul8s(player_vy_applied, tti_frames);
 
-                        fdx = pre_player_x - fighters[i].x;
-                        fdy = -pre_player_y + fighters[i].y;
-                        
-                        int16_t best_index = 0;
-                        int32_t max_dot = -8388608;
-                        
-                        for (uint8_t j = 0; j < SHIP_ROTATION_STEPS; j++) {
-                            int32_t current_dot = (int32_t)fdx * cos_fix[j] + (int32_t)fdy * sin_fix[j];
-                            if (current_dot > max_dot) {
-                                max_dot = current_dot;
-                                best_index = j;
-                            }
-                        }
+                        fdx = pre_player_x - fighter_x[i];
+                        fdy = -pre_player_y + fighter_y[i];
                         
-                        ebullets[current_ebullet_index].status = best_index;
-                        ebullets[current_ebullet_index].x = fighters[i].x;
-                        ebullets[current_ebullet_index].y = fighters[i].y;
-                        ebullets[current_ebullet_index].vx_rem = 0;
-                        ebullets[current_ebullet_index].vy_rem = 0;
+                        ebullet_status[current_ebullet_index] = heading_step(fdx, fdy);
+                        ebullet_x[current_ebullet_index] = fighter_x[i];
+                        ebullet_y[current_ebullet_index] = fighter_y[i];
+                        ebullet_vx_rem[current_ebullet_index] = 0;
+                        ebullet_vy_rem[current_ebullet_index] = 0;
                         
                         unsigned bullet_ptr = EBULLET_CONFIG + current_ebullet_index * sizeof(vga_mode4_sprite_t);
-                        xram0_struct_set(bullet_ptr, vga_mode4_sprite_t, x_pos_px, fighters[i].x);
-                        xram0_struct_set(bullet_ptr, vga_mode4_sprite_t, y_pos_px, fighters[i].y);
+                        sprite_move(bullet_ptr, &ebullet_shadow[current_ebullet_index], fighter_x[i], fighter_y[i]);
 
                         play_sound(SFX_TYPE_ENEMY_FIRE, 440, PSG_WAVE_TRIANGLE, 0, 4, 3, 3);
                         
-                        fighters[i].status = 2;
+                        fighter_status[i] = 2;
                         
                         current_ebullet_index++;
                         if (current_ebullet_index >= MAX_EBULLETS) {
@@ -384,17 +373,17 @@ void fire_ebullet(void)
                         break;
                     }
                 }
-            } else if (fighters[i].status > 1) {  // Cooling down after firing
-                fighters[i].status++;
-                if (fighters[i].status > max_ebullet_cooldown) {
-                    fighters[i].status = 1;
+            } else if (fighter_status[i] > 1) {  // Cooling down after firing
+                fighter_status[i]++;
+                if (fighter_status[i] > max_ebullet_cooldown) {
+                    fighter_status[i] = 1;
                 }
             }
         }
     }
 }
 
-void update_ebullets(void)
+PROFILED void update_ebullets(void)
 {
     // Decrement cooldown
     if (ebullet_cooldown > 0) {
@@ -403,133 +392,107 @@ void update_ebullets(void)
     
     // Adjust for scrolling
     for (uint8_t i = 0; i < MAX_EBULLETS; i++) {
-        if (ebullets[i].status >= 0) {
-            ebullets[i].x -= scroll_dx;
-            ebullets[i].y -= scroll_dy;
+        if (ebullet_status[i] >= 0) {
+            ebullet_x[i] -= scroll_dx;
+            ebullet_y[i] -= scroll_dy;
         }
     }
     
     for (uint8_t i = 0; i < MAX_EBULLETS; i++) {
         unsigned ptr = EBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
         
-        if (ebullets[i].status < 0) {
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+        if (ebullet_status[i] < 0) {
+            sprite_hide(ptr, &ebullet_shadow[i]);
             continue;
         }
         
-        if (player_x < ebullets[i].x + 2 &&
-            player_x + 8 > ebullets[i].x &&
-            player_y < ebullets[i].y + 2 &&
-            player_y + 8 > ebullets[i].y) {
-            
-            ebullets[i].status = -1;
-            enemy_score++;
-            
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-            
-            continue;
-        }
-
-        if ((i & 1) == (game_frame & 1)) {
-            if (check_asteroid_hit_no_score(ebullets[i].x, ebullets[i].y)) {
-                // Hit!
-                ebullets[i].status = -1; // Kill bullet
-                
-                continue; // Stop processing this bullet
-            }
-        }
-        
-        int16_t bvx = cos_fix[ebullets[i].status];
-        int16_t bvy = -sin_fix[ebullets[i].status];
-        
-        int16_t bvx_applied = (bvx + ebullets[i].vx_rem) >> 6;
-        int16_t bvy_applied = (bvy + ebullets[i].vy_rem) >> 6;
+        int16_t bvx = cos_fix[ebullet_status[i]];
+        int16_t bvy = -sin_fix[ebullet_status[i]];
         
-        ebullets[i].vx_rem = bvx + ebullets[i].vx_rem - (bvx_applied << 6);
-        ebullets[i].vy_rem = bvy + ebullets[i].vy_rem - (bvy_applied << 6);
+        int16_t bvx_applied = fx_step8(bvx, &ebullet_vx_rem[i], BULLET_VEL_FRAC);
+        int16_t bvy_applied = fx_step8(bvy, &ebullet_vy_rem[i], BULLET_VEL_FRAC);
         
-        ebullets[i].x += bvx_applied;
-        ebullets[i].y += bvy_applied;
+        ebullet_x[i] += bvx_applied;
+        ebullet_y[i] += bvy_applied;
         
-        if (ebullets[i].x > -10 && ebullets[i].x < SCREEN_WIDTH + 10 &&
-            ebullets[i].y > -10 && ebullets[i].y < SCREEN_HEIGHT + 10) {
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, ebullets[i].x);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, ebullets[i].y);
+        if (ebullet_x[i] > -10 && ebullet_x[i] < SCREEN_WIDTH + 10 &&
+            ebullet_y[i] > -10 && ebullet_y[i] < SCREEN_HEIGHT + 10) {
+            sprite_move(ptr, &ebullet_shadow[i], ebullet_x[i], ebullet_y[i]);
+            collide_add(CT_EBULLET, i, ebullet_x[i] + 1, ebullet_y[i] + 1);
         } else {
-            ebullets[i].status = -1;
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            ebullet_status[i] = -1;
+            sprite_hide(ptr, &ebullet_shadow[i]);
         }
     }
 }
 
 void render_fighters(void)
 {
-    for (uint8_t i = 0; i < MAX_FIGHTERS; i++) {
-        if (fighters[i].status > 0 || fighters[i].is_exploding) {
-            
-            unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
-
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, fighters[i].x);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, fighters[i].y);
-        } else {
-            unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        }
+    // Free fighters were hidden when their explosion ended
+    for (uint8_t k = fighter_pool.count; k-- > 0; ) {
+        uint8_t i = fighter_pool.slot[k];
+        unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
+        sprite_move(ptr, &fighter_shadow[i], fighter_x[i], fighter_y[i]);
     }
 }
 
 void move_fighters_offscreen(void)
 {
     for (uint8_t i = 0; i < MAX_FIGHTERS; i++) {
-        // if (fighters[i].status > 0) {
-            unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-            fighters[i].status = 0;
-        // }
+        unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
+        sprite_hide(ptr, &fighter_shadow[i]);
+        fighter_status[i] = 0;
+        if (!fighter_exploding[i]) {
+            pool_free(&fighter_pool, i);
+        }
+    }
+
+    // Everyone comes back together, one spawn delay from now
+    respawn_head = 0;
+    respawn_count = MAX_FIGHTERS;
+    for (uint8_t i = 0; i < MAX_FIGHTERS; i++) {
+        respawn_due[i] = fighter_clock + FIGHTER_SPAWN_RATE;
     }
 }
 
 void move_ebullets_offscreen(void)
 {
     for (uint8_t i = 0; i < MAX_EBULLETS; i++) {
-        if (ebullets[i].status >= 0) {
+        if (ebullet_status[i] >= 0) {
             unsigned ptr = EBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-            ebullets[i].status = -1;
+            sprite_hide(ptr, &ebullet_shadow[i]);
+            ebullet_status[i] = -1;
         }
     }
 }
 
-bool check_bullet_fighter_collision(int16_t bullet_x, int16_t bullet_y, 
-                                     int16_t* player_score_out, int16_t* game_score_out)
+bool fighter_live(uint8_t i)
 {
-    for (uint8_t f = 0; f < MAX_FIGHTERS; f++) {
-        if (fighters[f].status > 0) {
-            int16_t fighter_screen_x = fighters[f].x - scroll_dx;
-            int16_t fighter_screen_y = fighters[f].y - scroll_dy;
-            
-            if (bullet_x >= fighter_screen_x - 2 && bullet_x < fighter_screen_x + 6 &&
-                bullet_y >= fighter_screen_y - 2 && bullet_y < fighter_screen_y + 6) {
-                
-                fighters[f].status = 0;
-                fighters[f].is_exploding = true; // Start explosion sequenc
-                active_fighter_count--;
-                
-                // Award points based on current level
-                *player_score_out += 1;
-                *game_score_out += game_level;
-                
-                return true;
-            }
-        }
-    }
-    return false;
+    return fighter_status[i] > 0;
+}
+
+void kill_fighter(uint8_t i)
+{
+    fighter_status[i] = 0;
+    fighter_exploding[i] = true; // Start explosion sequence
+    active_fighter_count--;
+
+    // Stays live until the explosion ends; queue its comeback now
+    uint8_t tail = (respawn_head + respawn_count) % MAX_FIGHTERS;
+    respawn_due[tail] = fighter_clock + FIGHTER_SPAWN_RATE;
+    respawn_count++;
+}
+
+bool ebullet_live(uint8_t i)
+{
+    return ebullet_status[i] >= 0;
+}
+
+void kill_ebullet(uint8_t i)
+{
+    ebullet_status[i] = -1;
+    unsigned ptr = EBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
+    sprite_hide(ptr, &ebullet_shadow[i]);
 }
 
 void decrement_ebullet_cooldown(void)
@@ -559,3 +522,42 @@ void reset_fighter_difficulty(void)
     fighter_speed_min = INITIAL_FIGHTER_SPEED_MIN;
     fighter_speed_max = INITIAL_FIGHTER_SPEED_MAX;
 }
+
+#ifdef STRESS_TEST
+void stress_fill_fighters(void)
+{
+    // Every fighter flies: take back the free slots and drop the respawns
+    while (pool_alloc(&fighter_pool) != POOL_NONE) {}
+    respawn_count = 0;
+
+    for (uint8_t i = 0; i < MAX_FIGHTERS; i++) {
+        if (fighter_status[i] <= 0) {
+            fighter_vx_i[i] = random(fighter_speed_min, fighter_speed_max);
+            fighter_vy_i[i] = random(fighter_speed_min, fighter_speed_max);
+            fighter_status[i] = 1;
+            fighter_exploding[i] = false;
+            fighter_anim_timer[i] = 0;
+            set_fighter_frame(i, 0);
+            active_fighter_count++;
+        } else if (fighter_x[i] >= 0 && fighter_x[i] < SCREEN_WIDTH - 4 &&
+                   fighter_y[i] >= 0 && fighter_y[i] < SCREEN_HEIGHT - 4) {
+            continue;
+        }
+        // Dead or drifted off screen: put it back somewhere visible
+        fighter_x[i] = random(20, SCREEN_WIDTH - 20);
+        fighter_y[i] = random(20, SCREEN_HEIGHT - 20);
+    }
+
+    uint8_t f = 0;
+    for (uint8_t i = 0; i < MAX_EBULLETS; i++) {
+        if (ebullet_status[i] >= 0) continue;
+
+        ebullet_status[i] = random(0, SHIP_ROTATION_MASK);
+        ebullet_x[i] = fighter_x[f];
+        ebullet_y[i] = fighter_y[f];
+        ebullet_vx_rem[i] = 0;
+        ebullet_vy_rem[i] = 0;
+        f = (f + 3) % MAX_FIGHTERS;
+    }
+}
+#endif
@@ -10,7 +10,8 @@
 void init_fighters(void);
 
 /**
- * Update enemy fighter AI, movement, and collision detection
+ * Update enemy fighter AI and movement, registering each live fighter for
+ * run_collisions()
  */
 void update_fighters(void);
 
@@ -20,7 +21,8 @@ void update_fighters(void);
 void fire_ebullet(void);
 
 /**
- * Update enemy bullet positions and collision detection
+ * Update enemy bullet positions, registering each live one for
+ * run_collisions()
  */
 void update_ebullets(void);
 
@@ -40,11 +42,13 @@ void move_fighters_offscreen(void);
 void move_ebullets_offscreen(void);
 
 /**
- * Check if a bullet hit a fighter and handle the collision
- * Returns true if hit occurred
+ * Collision responses (see collision.c)
+ * A killed fighter starts its explosion sequence; a killed ebullet is hidden
  */
-bool check_bullet_fighter_collision(int16_t bullet_x, int16_t bullet_y, 
-                                     int16_t* player_score_out, int16_t* game_score_out);
+bool fighter_live(uint8_t i);
+void kill_fighter(uint8_t i);
+bool ebullet_live(uint8_t i);
+void kill_ebullet(uint8_t i);
 
 /**
  * Decrement ebullet cooldown timer
@@ -61,4 +65,12 @@ void increase_fighter_difficulty(void);
  */
 void reset_fighter_difficulty(void);
 
+#ifdef STRESS_TEST
+/**
+ * Stress mode: revive every fighter on screen and launch an enemy bullet
+ * from every free ebullet slot
+ */
+void stress_fill_fighters(void);
+#endif
+
 #endif // FIGHTERS_H
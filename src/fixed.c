@@ -0,0 +1,22 @@
+#include "fixed.h"
+#include <stdint.h>
+
+// ============================================================================
+// TABLES
+// ============================================================================
+
+uint16_t fx_sqr[511];
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+void init_fixed(void)
+{
+    // n * n / 4 grows by n / 2 (rounded down) from one n to the next
+    uint16_t sq = 0;
+    for (uint16_t n = 0; n < 511; n++) {
+        sq += n >> 1;
+        fx_sqr[n] = sq;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+/**
+ * fixed.h - Shared fixed-point motion and table-driven multiplies
+ *
+ * Velocities are signed fixed point with a per-mover number of fractional
+ * bits (PLAYER_VEL_FRAC and friends in constants.h). Positions stay whole
+ * pixels; each mover keeps the fraction it has not yet moved in a
+ * remainder, always 0 to (1 << frac) - 1, that the step helpers carry from
+ * frame to frame so slow speeds still add up exactly.
+ *
+ * fx_mul8() multiplies two bytes with the quarter-square identity
+ * a * b = sq(a + b) - sq(|a - b|), sq(n) = n * n / 4 rounded down, which is
+ * two table reads and a subtract instead of a shift-and-add loop. The table
+ * lives in RAM and is filled once by init_fixed().
+ */
+
+// sq(n) for n = 0 to 510
+extern uint16_t fx_sqr[511];
+
+/**
+ * Fill fx_sqr[] (once, before the first multiply)
+ */
+void init_fixed(void);
+
+/**
+ * Whole pixels to move this frame for velocity v with frac fractional bits
+ * (at most 8), carrying the rest in *rem
+ */
+static inline int16_t fx_step8(int16_t v, uint8_t *rem, uint8_t frac)
+{
+    int16_t t = v + *rem;
+    *rem = (uint8_t)t & (uint8_t)((1 << frac) - 1);
+    return t >> frac;
+}
+
+// fx_step8() for up to 15 fractional bits
+static inline int16_t fx_step16(int16_t v, uint16_t *rem, uint8_t frac)
+{
+    int16_t t = v + (int16_t)*rem;
+    *rem = (uint16_t)t & (uint16_t)((1u << frac) - 1);
+    return t >> frac;
+}
+
+// Unsigned 8 x 8 -> 16 bit multiply
+static inline uint16_t fx_mul8(uint8_t a, uint8_t b)
+{
+    uint8_t d = (a >= b) ? a - b : b - a;
+    return fx_sqr[a + b] - fx_sqr[d];
+}
+
+// Signed 8 x unsigned 8 -> 16 bit multiply
+static inline int16_t fx_mul8s(int8_t a, uint8_t b)
+{
+    if (a < 0) return -(int16_t)fx_mul8((uint8_t)-a, b);
+    return (int16_t)fx_mul8((uint8_t)a, b);
+}
+
+#endif // FIXED_H
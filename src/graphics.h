@@ -7,11 +7,12 @@
 // Swap macro for line drawing
 #define swap(a, b) { uint16_t t = a; a = b; b = t; }
 
-// Routine for placing a single dot on the screen for 8bit-colour depth
+// Routine for placing a single dot on the screen for 8bit-colour depth.
+// Plots use port 0 for random access; a single write does not depend on
+// step0, so it is left alone. Port 1 is the XRAM stream (xram_queue.h).
 static inline void set(int16_t x, int16_t y, uint8_t colour)
 {
     RIA.addr0 =  x + (SCREEN_WIDTH * y);
-    RIA.step0 = 1;
     RIA.rw0 = colour;
 }
 
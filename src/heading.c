@@ -0,0 +1,49 @@
+#include "heading.h"
+#include "constants.h"
+#include <stdint.h>
+
+// ============================================================================
+// CONSTANTS
+// ============================================================================
+
+#define QUARTER_STEPS   (SHIP_ROTATION_STEPS / 4)
+#define HALF_STEPS      (SHIP_ROTATION_STEPS / 2)
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+uint8_t heading_step(int16_t dx, int16_t dy)
+{
+    uint16_t ax = (dx < 0) ? -(uint16_t)dx : (uint16_t)dx;
+    uint16_t ay = (dy < 0) ? -(uint16_t)dy : (uint16_t)dy;
+
+    // Fold into the first octant: minor <= major
+    uint16_t major = (ax >= ay) ? ax : ay;
+    uint16_t minor = (ax >= ay) ? ay : ax;
+    if (major == 0) return 0;
+
+    // Keep the doubling below from overflowing
+    while (major > 0x7FFF) {
+        major >>= 1;
+        minor >>= 1;
+    }
+
+    // ratio = minor * HEADING_RATIOS / major, one quotient bit per pass
+    uint8_t ratio = 0;
+    for (uint8_t b = 0; b < HEADING_RATIO_BITS; b++) {
+        minor <<= 1;
+        ratio <<= 1;
+        if (minor >= major) {
+            minor -= major;
+            ratio |= 1;
+        }
+    }
+
+    // Unfold: octant, then quadrant
+    uint8_t step = heading_octant[ratio];
+    if (ay > ax) step = QUARTER_STEPS - step;
+    if (dx < 0) step = HALF_STEPS - step;
+    if (dy < 0) step = SHIP_ROTATION_STEPS - step;
+    return step & SHIP_ROTATION_MASK;
+}
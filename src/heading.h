@@ -0,0 +1,31 @@
+#ifndef HEADING_H
+#define HEADING_H
+
+#include <stdint.h>
+
+/**
+ * heading.h - Direction to rotation step, without multiplies
+ *
+ * heading_step() folds a vector into the first octant, takes the ratio of
+ * its short side to its long side with a few shift-and-subtract steps, and
+ * looks the angle up in heading_octant[]. The table is generated at build
+ * time by tools/gen_trig_tables.py.
+ *
+ * Steps count counter-clockwise from +x in 360 / SHIP_ROTATION_STEPS degree
+ * units with y pointing up, the same convention as sin_fix/cos_fix: step r
+ * points along (cos_fix[r], sin_fix[r]).
+ */
+
+#define HEADING_RATIO_BITS  6
+#define HEADING_RATIOS      (1 << HEADING_RATIO_BITS)
+
+// Nearest rotation step within the first octant, by ratio * HEADING_RATIOS
+extern const uint8_t heading_octant[HEADING_RATIOS];
+
+/**
+ * Rotation step (0 to SHIP_ROTATION_STEPS - 1) nearest the direction of
+ * (dx, dy), y up. (0, 0) gives step 0.
+ */
+uint8_t heading_step(int16_t dx, int16_t dy);
+
+#endif // HEADING_H
@@ -6,6 +6,7 @@
 #include "constants.h"
 #include "input.h"
 #include "music.h"
+#include "idle.h"
 #include <stdio.h>
 #include <string.h>
 #include <rp6502.h>
@@ -17,6 +18,10 @@ extern void clear_rect(int16_t x, int16_t y, int16_t width, int16_t height);
 // High score data
 static HighScore high_scores[MAX_HIGH_SCORES];
 
+// Progress of the table being painted: 0 = title, then row - 1
+static uint8_t paint_step;
+static uint8_t paint_frame;         // vsync the colours are cycled from
+
 /**
  * Initialize high scores with default values
  */
@@ -27,7 +32,7 @@ void init_high_scores(void)
         high_scores[i].name[1] = 'A';
         high_scores[i].name[2] = 'A';
         high_scores[i].name[3] = '\0';
-        high_scores[i].score = (MAX_HIGH_SCORES - i) * 10;  // 100, 90, 80, ...
+        high_scores[i].score = bcd_from_u8((MAX_HIGH_SCORES - i) * 10);  // 100, 90, 80, ...
     }
 }
 
@@ -47,7 +52,13 @@ bool load_high_scores(void)
     size_t read = fread(high_scores, sizeof(HighScore), MAX_HIGH_SCORES, fp);
     fclose(fp);
     
-    if (read != MAX_HIGH_SCORES) {
+    // A short read or a score that is not BCD means an unreadable file
+    // (or one saved before scores were BCD)
+    bool valid = (read == MAX_HIGH_SCORES);
+    for (uint8_t i = 0; valid && i < MAX_HIGH_SCORES; i++) {
+        valid = bcd_valid(high_scores[i].score);
+    }
+    if (!valid) {
         printf("Error reading high scores, initializing defaults\n");
         init_high_scores();
         return false;
@@ -77,7 +88,7 @@ void save_high_scores(void)
  * Check if score qualifies for high score list
  * Returns the position (0-9) if it qualifies, -1 otherwise
  */
-int8_t check_high_score(int16_t score)
+int8_t check_high_score(bcd_t score)
 {
     for (uint8_t i = 0; i < MAX_HIGH_SCORES; i++) {
         if (score > high_scores[i].score) {
@@ -91,7 +102,7 @@ int8_t check_high_score(int16_t score)
  * Insert a new high score at the given position
  * Shifts lower scores down
  */
-void insert_high_score(int8_t position, const char* name, int16_t score)
+void insert_high_score(int8_t position, const char* name, bcd_t score)
 {
     if (position < 0 || position >= MAX_HIGH_SCORES) return;
     
@@ -107,9 +118,11 @@ void insert_high_score(int8_t position, const char* name, int16_t score)
 }
 
 /**
- * Display high scores on screen
+ * Paint the next part of the high score table: the title, then one row
+ * per call (an idle.h job)
+ * @return true while rows remain
  */
-void draw_high_scores(void)
+static bool paint_high_scores(void)
 {
     const uint8_t color_cycle[] = {0xE3, 0x1F, 0xFF, 0xF8, 0x3F, 0x07, 0xC7}; // yellow, blue, white, red, green, cyan, magenta
     const uint8_t color_cycle_len = sizeof(color_cycle) / sizeof(color_cycle[0]);
@@ -117,47 +130,70 @@ void draw_high_scores(void)
     const uint16_t start_y = 40;
 
     // Animate color based on vsync/frame (arcade effect)
-    uint8_t frame = RIA.vsync;
+    uint8_t frame = paint_frame;
 
-    // Draw title with animated color
-    uint8_t title_color = color_cycle[(frame / 8) % color_cycle_len];
-    draw_text(start_x + 23 , start_y + 3, "HIGH SCORES", title_color);
+    if (paint_step == 0) {
+        // Draw title with animated color
+        uint8_t title_color = color_cycle[(frame / 8) % color_cycle_len];
+        draw_text(start_x + 23 , start_y + 3, "HIGH SCORES", title_color);
+        paint_step++;
+        return true;
+    }
 
-    // Draw each score with animated color cycling
-    for (uint8_t i = 0; i < MAX_HIGH_SCORES; i++) {
-        uint16_t y = start_y + 15 + (i * 8);
-        // uint8_t row_color = color_cycle[(frame / 8 + i) % color_cycle_len];
-        uint8_t base_idx = 32;
-        uint8_t offset = (frame + (i * 10)) % 224; // Speed and spacing
-        uint8_t row_color = base_idx + offset;
+    // Draw the next row with animated color cycling
+    uint8_t i = paint_step - 1;
+    uint16_t y = start_y + 15 + (i * 8);
+    // uint8_t row_color = color_cycle[(frame / 8 + i) % color_cycle_len];
+    uint8_t base_idx = 32;
+    uint8_t offset = (frame + (i * 10)) % 224; // Speed and spacing
+    uint8_t row_color = base_idx + offset;
 
-        // Draw rank number
-        char rank[3];
-        if (i == 9) {
-            rank[0] = '1';
-            rank[1] = '0';
-            rank[2] = '\0';
-        } else {
-            rank[0] = '1' + i;
-            rank[1] = '\0';
-        }
-        draw_text(start_x + 20, y, rank, row_color);
+    // Draw rank number
+    char rank[3];
+    if (i == 9) {
+        rank[0] = '1';
+        rank[1] = '0';
+        rank[2] = '\0';
+    } else {
+        rank[0] = '1' + i;
+        rank[1] = '\0';
+    }
+    draw_text(start_x + 20, y, rank, row_color);
+
+    // Draw name
+    draw_text(start_x + 30, y, high_scores[i].name, row_color);
 
-        // Draw name
-        draw_text(start_x + 30, y, high_scores[i].name, row_color);
+    // Draw score (5 digits)
+    char score_buf[6];
+    bcd_digits(score_buf, high_scores[i].score, 5);
+    score_buf[5] = '\0';
+    draw_text(start_x + 50, y, score_buf, row_color);
+
+    paint_step++;
+    return paint_step <= MAX_HIGH_SCORES;
+}
 
-        // Draw score (5 digits)
-        char score_buf[6];
-        score_buf[0] = '0' + (high_scores[i].score / 10000) % 10;
-        score_buf[1] = '0' + (high_scores[i].score / 1000) % 10;
-        score_buf[2] = '0' + (high_scores[i].score / 100) % 10;
-        score_buf[3] = '0' + (high_scores[i].score / 10) % 10;
-        score_buf[4] = '0' + high_scores[i].score % 10;
-        score_buf[5] = '\0';
-        draw_text(start_x + 50, y, score_buf, row_color);
+/**
+ * Display high scores on screen
+ */
+void draw_high_scores(void)
+{
+    paint_step = 0;
+    paint_frame = RIA.vsync;
+    while (paint_high_scores()) {
     }
 }
 
+/**
+ * Repaint the high scores a row at a time in idle time
+ */
+void repaint_high_scores(void)
+{
+    paint_step = 0;
+    paint_frame = RIA.vsync;
+    idle_post(paint_high_scores);
+}
+
 /**
  * Get player initials for high score entry
  */
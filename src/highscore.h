@@ -9,19 +9,20 @@
 #include <stdbool.h>
 #include "constants.h"
 
-// High score structure
+// High score structure (also the file record)
 typedef struct {
     char name[HIGH_SCORE_NAME_LEN + 1];  // 3 chars + null terminator
-    int16_t score;
+    bcd_t score;                         // Packed BCD (bcd.h)
 } HighScore;
 
 // High score functions
 void init_high_scores(void);
 bool load_high_scores(void);
 void save_high_scores(void);
-int8_t check_high_score(int16_t score);
-void insert_high_score(int8_t position, const char* name, int16_t score);
+int8_t check_high_score(bcd_t score);
+void insert_high_score(int8_t position, const char* name, bcd_t score);
 void draw_high_scores(void);
+void repaint_high_scores(void);
 void get_player_initials(char* name);
 
 #endif // HIGHSCORE_H
@@ -1,16 +1,12 @@
 #include "hud.h"
 #include "constants.h"
+#include "xram_queue.h"
 #include <rp6502.h>
 #include <stdint.h>
 #include <stdbool.h>
 
-// Access to text RAM pointer defined in main module
-extern unsigned text_message_addr;
-
 // External dependencies from main game
-extern int16_t player_score;
-extern int16_t enemy_score;
-extern int16_t game_score;
+extern bcd_t game_score;
 extern int16_t game_level;
 
 // Graphics functions from main file
@@ -27,21 +23,39 @@ static inline void set(int16_t x, int16_t y, uint8_t color)
 {
     if (x >= 0 && x < 320 && y >= 0 && y < 180) {
         RIA.addr0 = x + (SCREEN_WIDTH * y);
-        RIA.step0 = 1;
         RIA.rw0 = color;
     }
 }
 
 // Old pixel-based bar drawing functions removed — HUD now uses text-plane block bars.
 
+// Score (packed BCD) at which each block of an 8-block bar fills: the
+// multiples of SCORE_TO_WIN / 8, rounded up. Written out for a target of
+// 100, so recompute them if SCORE_TO_WIN changes.
+#if SCORE_TO_WIN != 0x100
+#error "bar_steps assumes SCORE_TO_WIN is 100 (0x100 in BCD)"
+#endif
+static const bcd_t bar_steps[8] = {
+    0x13, 0x25, 0x38, 0x50, 0x63, 0x75, 0x88, 0x100
+};
+
+// Blocks of a bar filled at the given score
+static uint8_t bar_fill(bcd_t score)
+{
+    uint8_t filled = 0;
+    while (filled < 8 && score >= bar_steps[filled]) filled++;
+    return filled;
+}
+
 /**
  * Draw the HUD (score, health, etc.)
  */
-void draw_hud(void)
+PROFILED void draw_hud(void)
 {
-    static int16_t prev_player_score = -1;
-    static int16_t prev_enemy_score = -1;
-    static int16_t prev_game_score = -1;
+    // Not valid BCD, so the first call always draws
+    static bcd_t prev_player_score = 0xFFFFFFFF;
+    static bcd_t prev_enemy_score = 0xFFFFFFFF;
+    static bcd_t prev_game_score = 0xFFFFFFFF;
     static int16_t prev_game_level = -1;
     
     const uint8_t hud_y = 2;
@@ -76,9 +90,7 @@ void draw_hud(void)
     
     // Update player score (3 digits) directly in text RAM
     char score_buf[4];
-    score_buf[0] = '0' + (player_score / 100) % 10;
-    score_buf[1] = '0' + (player_score / 10) % 10;
-    score_buf[2] = '0' + player_score % 10;
+    bcd_digits(score_buf, player_score, 3);
     score_buf[3] = '\0';
 
     // Message layout matches main text: left_pad places player score at start
@@ -88,96 +100,73 @@ void draw_hud(void)
     const int player_index = left_pad; // player score begins here
 
     // Each character in text RAM is 3 bytes (char, palette/attr, extra)
-    unsigned addr = text_message_addr + player_index * 3;
-    RIA.addr0 = addr;
-    RIA.step0 = 1;
+    unsigned addr = TEXT_MESSAGE_DATA + player_index * 3;
 
     for (uint8_t k = 0; k < 3; ++k) {
-        RIA.rw0 = score_buf[k];
-        RIA.rw0 = 0xE0; // normal text attribute
-        RIA.rw0 = 0x00; // extra/unused
+        xram_put(addr++, score_buf[k]);
+        xram_put(addr++, 0xE0); // normal text attribute
+        xram_put(addr++, 0x00); // extra/unused
     }
     
     // Draw BAR1 as text-plane blocks (8 chars). Grey when 0, fill with color to 100.
     const int block_chars = 8;
     const int block1_start = player_index + 3 + 1; // after player(3) + space
-    int filled1 = (player_score * block_chars) / SCORE_TO_WIN;
-    if (filled1 < 0) filled1 = 0;
-    if (filled1 > block_chars) filled1 = block_chars;
+    int filled1 = bar_fill(player_score);
 
-    unsigned b1_addr = text_message_addr + block1_start * 3;
-    RIA.addr0 = b1_addr;
-    RIA.step0 = 1;
+    unsigned b1_addr = TEXT_MESSAGE_DATA + block1_start * 3;
     for (int i = 0; i < block_chars; ++i) {
-        RIA.rw0 = 0xDB; // block glyph
-        if (i < filled1) RIA.rw0 = BLOCK1_ATTR; else RIA.rw0 = BLOCK_EMPTY_ATTR;
-        RIA.rw0 = 0x10;
+        xram_put(b1_addr++, 0xDB); // block glyph
+        xram_put(b1_addr++, i < filled1 ? BLOCK1_ATTR : BLOCK_EMPTY_ATTR);
+        xram_put(b1_addr++, 0x10);
     }
     
     // Update game score (5 digits) directly in text RAM
     char game_score_buf[6];
-    game_score_buf[0] = '0' + (game_score / 10000) % 10;
-    game_score_buf[1] = '0' + (game_score / 1000) % 10;
-    game_score_buf[2] = '0' + (game_score / 100) % 10;
-    game_score_buf[3] = '0' + (game_score / 10) % 10;
-    game_score_buf[4] = '0' + game_score % 10;
+    bcd_digits(game_score_buf, game_score, 5);
     game_score_buf[5] = '\0';
 
     const int game_index = player_index + 3 + 1 + 8 + 1; // left_pad + 13
 
-    unsigned game_addr = text_message_addr + game_index * 3;
-    RIA.addr0 = game_addr;
-    RIA.step0 = 1;
+    unsigned game_addr = TEXT_MESSAGE_DATA + game_index * 3;
     for (uint8_t k = 0; k < 5; ++k) {
-        RIA.rw0 = game_score_buf[k];
-        RIA.rw0 = 0xE0;
-        RIA.rw0 = 0x00;
+        xram_put(game_addr++, game_score_buf[k]);
+        xram_put(game_addr++, 0xE0);
+        xram_put(game_addr++, 0x00);
     }
     
     // Draw BAR2 as text-plane blocks (8 chars), filled right-to-left.
     const int block2_start = player_index + 3 + 1 + 8 + 1 + 5 + 1; // after player, space, block1, space, game, space
-    int filled2 = (enemy_score * block_chars) / SCORE_TO_WIN;
-    if (filled2 < 0) filled2 = 0;
-    if (filled2 > block_chars) filled2 = block_chars;
+    int filled2 = bar_fill(enemy_score);
 
-    unsigned b2_addr = text_message_addr + block2_start * 3;
-    RIA.addr0 = b2_addr;
-    RIA.step0 = 1;
+    unsigned b2_addr = TEXT_MESSAGE_DATA + block2_start * 3;
     for (int i = 0; i < block_chars; ++i) {
-        RIA.rw0 = 0xDB; // block glyph
+        xram_put(b2_addr++, 0xDB); // block glyph
         // fill from right: positions >= (block_chars - filled2) are filled
-        if (i >= (block_chars - filled2)) RIA.rw0 = BLOCK2_ATTR; else RIA.rw0 = BLOCK_EMPTY_ATTR;
-        RIA.rw0 = 0x10;
+        xram_put(b2_addr++, i >= (block_chars - filled2) ? BLOCK2_ATTR : BLOCK_EMPTY_ATTR);
+        xram_put(b2_addr++, 0x10);
     }
     
     // Update enemy score (3 digits) directly in text RAM
-    score_buf[0] = '0' + (enemy_score / 100) % 10;
-    score_buf[1] = '0' + (enemy_score / 10) % 10;
-    score_buf[2] = '0' + enemy_score % 10;
+    bcd_digits(score_buf, enemy_score, 3);
 
     const int enemy_index = game_index + 5 + 1 + 8 + 1; // game_index + 15 -> left_pad + 28? (results in 30)
-    unsigned enemy_addr = text_message_addr + enemy_index * 3;
-    RIA.addr0 = enemy_addr;
-    RIA.step0 = 1;
+    unsigned enemy_addr = TEXT_MESSAGE_DATA + enemy_index * 3;
     for (uint8_t k = 0; k < 3; ++k) {
-        RIA.rw0 = score_buf[k];
-        RIA.rw0 = 0xE0;
-        RIA.rw0 = 0x00;
+        xram_put(enemy_addr++, score_buf[k]);
+        xram_put(enemy_addr++, 0xE0);
+        xram_put(enemy_addr++, 0x00);
     }
 
     // Write level digits: compute byte address in text RAM (3 bytes per char)
     // Move level display further right by 15 chars to align with message layout
     const int level_index = enemy_index + 13 + 12; // character index where level digits live
-    unsigned level_addr = text_message_addr + level_index * 3;
-    RIA.addr0 = level_addr;
-    RIA.step0 = 1;
+    unsigned level_addr = TEXT_MESSAGE_DATA + level_index * 3;
     char level_buf[2];
-    level_buf[0] = '0' + (game_level / 10) % 10;
-    level_buf[1] = '0' + game_level % 10;
+    bcd_digits(level_buf, bcd_from_u8(game_level), 2);
     for (uint8_t k = 0; k < 2; ++k) {
-        RIA.rw0 = level_buf[k];
-        RIA.rw0 = 0xE0;
-        RIA.rw0 = 0x00;
+        xram_put(level_addr++, level_buf[k]);
+        xram_put(level_addr++, 0xE0);
+        xram_put(level_addr++, 0x00);
     }
     
 }
@@ -0,0 +1,54 @@
+#include "idle.h"
+#include <rp6502.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static idle_job_t jobs[IDLE_MAX_JOBS];
+static uint8_t job_count = 0;
+static uint8_t turn = 0;            // Queue position of the next slice
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+bool idle_post(idle_job_t job)
+{
+    for (uint8_t k = 0; k < job_count; k++) {
+        if (jobs[k] == job) return true;
+    }
+    if (job_count == IDLE_MAX_JOBS) return false;
+
+    jobs[job_count++] = job;
+    return true;
+}
+
+void idle_clear(void)
+{
+    job_count = 0;
+    turn = 0;
+}
+
+void idle_run(uint8_t vsync_last)
+{
+    // The caller has just seen vsync unchanged, so there is time for a
+    // slice before the next check
+    while (job_count > 0) {
+        if (turn >= job_count) turn = 0;
+
+        if (jobs[turn]()) {
+            turn++;
+        } else {
+            // Finished: close the gap, keeping the order
+            job_count--;
+            for (uint8_t k = turn; k < job_count; k++) {
+                jobs[k] = jobs[k + 1];
+            }
+        }
+
+        if (RIA.vsync != vsync_last) break;
+    }
+}
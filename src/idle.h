@@ -0,0 +1,40 @@
+#ifndef IDLE_H
+#define IDLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * idle.h - Cooperative jobs for the time spent waiting for vsync
+ *
+ * A frame that finishes early used to spin on RIA.vsync until the next
+ * one. idle_run() spends that wait on queued jobs instead. A job does one
+ * short, bounded slice of work per call, keeps its own progress between
+ * calls, and returns true while it has more to do; once it returns false
+ * it leaves the queue. Queued jobs take turns a slice at a time, and
+ * idle_run() returns as soon as vsync ticks, so only the slice in progress
+ * can run into the next frame.
+ */
+
+#define IDLE_MAX_JOBS 4
+
+typedef bool (*idle_job_t)(void);
+
+/**
+ * Queue a job, unless it is already queued
+ * @return false if the queue is full
+ */
+bool idle_post(idle_job_t job);
+
+/**
+ * Drop every queued job (when leaving a screen whose jobs draw on it)
+ */
+void idle_clear(void);
+
+/**
+ * Run queued slices until vsync moves on from vsync_last or the queue is
+ * empty (call from the vsync wait)
+ */
+void idle_run(uint8_t vsync_last);
+
+#endif // IDLE_H
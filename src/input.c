@@ -1,6 +1,7 @@
 #include "input.h"
 #include "constants.h"
 #include "usb_hid_keys.h"
+#include "replay.h"
 #include <rp6502.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -24,6 +25,11 @@ ButtonMapping button_mappings[GAMEPAD_COUNT][ACTION_COUNT];
  */
 void handle_input(void)
 {
+#ifdef INPUT_PLAYBACK
+    // A replay supplies this frame's input instead of XRAM
+    if (replay_frame()) return;
+#endif
+
     // Read all keyboard state bytes
     RIA.addr0 = KEYBOARD_INPUT;
     RIA.step0 = 1;
@@ -46,7 +52,10 @@ void handle_input(void)
         gamepad[i].l2 = RIA.rw0;
         gamepad[i].r2 = RIA.rw0;
     }
-    
+
+#ifdef INPUT_RECORD
+    replay_frame();
+#endif
 }
 
 /**
@@ -1,5 +1,6 @@
 #include "music.h"
 #include "constants.h"
+#include "xram_queue.h"
 #include <rp6502.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -203,47 +204,40 @@ static void set_note(uint8_t channel, uint16_t freq, uint8_t instrument)
     
     if (freq == 0) {
         // Rest - gate off
-        RIA.addr0 = psg_addr + 6;  // pan_gate offset
-        RIA.rw0 = 0x00;
+        xram_put(psg_addr + 6, 0x00);  // pan_gate offset
         return;
     }
     
     // Set frequency (Hz * 3)
     uint16_t freq_val = freq * 3;
-    RIA.addr0 = psg_addr;
-    RIA.step0 = 1;
-    RIA.rw0 = freq_val & 0xFF;          // freq low byte
-    RIA.rw0 = (freq_val >> 8) & 0xFF;   // freq high byte
+    xram_put16(psg_addr, freq_val);     // freq low, high byte
     
     // Configure based on instrument type
     if (instrument == INSTRUMENT_HIHAT) {
     // Closed Hi-hat: Noise with a very fast attack and a quick decay to silence.
-        RIA.rw0 = 255;                      // Duty cycle (not used for noise)
-        RIA.rw0 = (4 << 4) | 0;           // vol_attack: Loudest volume (0), fastest attack (0)
-        RIA.rw0 = (15 << 4) | 2;          // vol_decay: Sustain at silence (15), fast decay rate (2)
-        RIA.rw0 = (WAVE_NOISE << 4) | 2;  // wave_release: Noise waveform, fast release rate (2)
-        RIA.step0 = 0;                    // Frequency (not critical for noise)
-        RIA.rw0 = 0x01;
+        xram_put(psg_addr + 2, 255);                    // Duty cycle (not used for noise)
+        xram_put(psg_addr + 3, (4 << 4) | 0);           // vol_attack: Loudest volume (0), fastest attack (0)
+        xram_put(psg_addr + 4, (15 << 4) | 2);          // vol_decay: Sustain at silence (15), fast decay rate (2)
+        xram_put(psg_addr + 5, (WAVE_NOISE << 4) | 2);  // wave_release: Noise waveform, fast release rate (2)
+        xram_put(psg_addr + 6, 0x01);                   // pan center, gate on
     } else if (instrument == INSTRUMENT_KICK) {
         // Kick drum - noise wave with punch and sustain
-        RIA.rw0 = 128;            // duty cycle (lower for tighter sound)
-        RIA.rw0 = (0 << 4) | 0;           // vol_attack: Loudest volume (0), fastest attack (0)
-        RIA.rw0 = (15 << 4) | 7;          // vol_decay: Sustain at silence (15), medium decay (~240ms)
-        RIA.rw0 = (WAVE_TRIANGLE << 4) | 0;  // wave_release (noise, release 0)
-        RIA.step0 = 0;
-        RIA.rw0 = 0x01;         // pan center, gate on
+        xram_put(psg_addr + 2, 128);            // duty cycle (lower for tighter sound)
+        xram_put(psg_addr + 3, (0 << 4) | 0);           // vol_attack: Loudest volume (0), fastest attack (0)
+        xram_put(psg_addr + 4, (15 << 4) | 7);          // vol_decay: Sustain at silence (15), medium decay (~240ms)
+        xram_put(psg_addr + 5, (WAVE_TRIANGLE << 4) | 0);  // wave_release (noise, release 0)
+        xram_put(psg_addr + 6, 0x01);         // pan center, gate on
     } else {
         // Normal note - bass uses triangle wave on channel 5
         // Note: Since we call start_music(NULL, title_bass, NULL, NULL),
         // bass is the only active track and uses channel 5
         uint8_t waveform = WAVE_TRIANGLE;  // Always triangle for bass-only music
         
-        RIA.rw0 = 64;          // Set duty cycle (50%)
-        RIA.rw0 = (0 << 4) | 1; // Set volume (0 = LOUDEST) and attack (1 = fast)
-        RIA.rw0 = (10 << 4) | 2; // Set decay volume (10 = loud sustain) and decay (2)
-        RIA.rw0 = (waveform << 4) | 3; // Set waveform and release (3)
-        RIA.step0 = 0;
-        RIA.rw0 = 0x01;         // Set pan (center) and gate (on)
+        xram_put(psg_addr + 2, 64);          // Set duty cycle (50%)
+        xram_put(psg_addr + 3, (0 << 4) | 1); // Set volume (0 = LOUDEST) and attack (1 = fast)
+        xram_put(psg_addr + 4, (10 << 4) | 2); // Set decay volume (10 = loud sustain) and decay (2)
+        xram_put(psg_addr + 5, (waveform << 4) | 3); // Set waveform and release (3)
+        xram_put(psg_addr + 6, 0x01);         // Set pan (center) and gate (on)
     }
 }
 
@@ -257,8 +251,7 @@ static void stop_note(uint8_t channel)
     }
     
     uint16_t psg_addr = PSG_XRAM_ADDR + (channel * 8) + 6;  // pan_gate offset
-    RIA.addr0 = psg_addr;
-    RIA.rw0 = 0x00;  // Gate off
+    xram_put(psg_addr, 0x00);  // Gate off
 }
 
 /**
@@ -0,0 +1,122 @@
+#include "perf_hud.h"
+#include "constants.h"
+#include "xram_queue.h"
+#include <rp6502.h>
+#include <stdint.h>
+
+#ifdef PERF_HUD
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+// Cost of each of the last PERF_HUD_WINDOW frames, as a histogram bucket
+static uint8_t frame_bucket[PERF_HUD_WINDOW];
+static uint8_t bucket_count[4];
+static uint8_t window_pos = 0;
+
+static uint16_t missed_frames = 0;
+static uint8_t worst_delta = 1;
+
+// Text-plane cell the next perf_hud_char() writes
+static unsigned cell_addr;
+
+// Character index of the second text row (MESSAGE_WIDTH in definitions.h)
+#define PERF_HUD_ROW_START  36
+#define PERF_HUD_LEFT_COL   0   // "MISS 00000 W1"
+#define PERF_HUD_RIGHT_COL  23  // "H 64 00 00 00"
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+void perf_hud_reset(void)
+{
+    for (uint8_t i = 0; i < PERF_HUD_WINDOW; i++) {
+        frame_bucket[i] = 0;
+    }
+    bucket_count[0] = PERF_HUD_WINDOW;
+    bucket_count[1] = 0;
+    bucket_count[2] = 0;
+    bucket_count[3] = 0;
+    window_pos = 0;
+    missed_frames = 0;
+    worst_delta = 1;
+}
+
+/**
+ * Start writing text-plane characters at a column of the perf HUD row
+ */
+static void perf_hud_seek(uint8_t col)
+{
+    cell_addr = TEXT_MESSAGE_DATA + (PERF_HUD_ROW_START + col) * 3;
+}
+
+// Queued with the HUD's own cells, so both land in the same flush
+static void perf_hud_char(char c)
+{
+    xram_put(cell_addr++, c);
+    xram_put(cell_addr++, 0xE0); // normal text attribute
+    xram_put(cell_addr++, 0x00); // extra/unused
+}
+
+static void perf_hud_digits(uint16_t value, uint8_t digits)
+{
+    char buf[5];
+    for (uint8_t i = digits; i > 0; i--) {
+        buf[i - 1] = '0' + value % 10;
+        value /= 10;
+    }
+    for (uint8_t i = 0; i < digits; i++) {
+        perf_hud_char(buf[i]);
+    }
+}
+
+static void perf_hud_draw(void)
+{
+    perf_hud_seek(PERF_HUD_LEFT_COL);
+    perf_hud_char('M');
+    perf_hud_char('I');
+    perf_hud_char('S');
+    perf_hud_char('S');
+    perf_hud_char(' ');
+    perf_hud_digits(missed_frames, 5);
+    perf_hud_char(' ');
+    perf_hud_char('W');
+    perf_hud_digits(worst_delta, 1);
+
+    perf_hud_seek(PERF_HUD_RIGHT_COL);
+    perf_hud_char('H');
+    for (uint8_t b = 0; b < 4; b++) {
+        perf_hud_char(' ');
+        perf_hud_digits(bucket_count[b] > 99 ? 99 : bucket_count[b], 2);
+    }
+}
+
+void perf_hud_frame(uint8_t vsync_delta)
+{
+    if (vsync_delta == 0 || vsync_delta > PERF_HUD_MAX_DELTA) {
+        return;
+    }
+
+    if (vsync_delta > 1) {
+        uint16_t missed = missed_frames + (vsync_delta - 1);
+        missed_frames = missed < missed_frames ? 0xFFFF : missed;
+    }
+    if (vsync_delta > worst_delta) {
+        worst_delta = vsync_delta > 9 ? 9 : vsync_delta;
+    }
+
+    // Replace the oldest frame in the rolling window
+    uint8_t bucket = vsync_delta > 4 ? 3 : vsync_delta - 1;
+    bucket_count[frame_bucket[window_pos]]--;
+    bucket_count[bucket]++;
+    frame_bucket[window_pos] = bucket;
+    window_pos = (window_pos + 1) & (PERF_HUD_WINDOW - 1);
+
+    if ((window_pos & 15) == 0) {
+        perf_hud_draw();
+    }
+}
+
+#endif // PERF_HUD
@@ -0,0 +1,38 @@
+#ifndef PERF_HUD_H
+#define PERF_HUD_H
+
+#include <stdint.h>
+
+/**
+ * perf_hud.h - Frame-overrun counters on the text plane (debug builds only)
+ *
+ * Compiled in with the ENABLE_PERF_HUD CMake option (defines PERF_HUD).
+ * The gameplay loop reports how many vsyncs passed since its previous
+ * iteration; anything above 1 is a dropped frame. The counters are drawn in
+ * the spare columns of the second text row, either side of "LEVEL XX":
+ *
+ *   MISS 00000 W1           LEVEL01    H 64 00 00 00
+ *
+ * MISS is the total of dropped frames this game, W the worst vsync delta,
+ * and H a histogram of the last PERF_HUD_WINDOW frames by cost
+ * (1, 2, 3 and 4+ vsyncs).
+ */
+
+#ifdef PERF_HUD
+
+// Frames kept in the rolling histogram (power of two)
+#define PERF_HUD_WINDOW 64
+
+// Deltas above this are a blocking screen (level up), not a slow frame
+#define PERF_HUD_MAX_DELTA 15
+
+// Clear all counters (call when starting a new game)
+void perf_hud_reset(void);
+
+// Record one gameplay frame that took vsync_delta vsyncs and redraw the
+// counters every 16 frames
+void perf_hud_frame(uint8_t vsync_delta);
+
+#endif // PERF_HUD
+
+#endif // PERF_HUD_H
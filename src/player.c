@@ -9,28 +9,25 @@
 #include <stdbool.h>
 #include <stdio.h> // added for printf debugging
 #include "explosions.h"
-
-// ============================================================================
-// TYPES
-// ============================================================================
-
-// Bullet type defined in bullets.h
+#include "sprite_shadow.h"
+#include "trig_tables.h"
+#include "collision.h"
+#include "heading.h"
+#include "fixed.h"
 
 // ============================================================================
 // EXTERNAL DEPENDENCIES
 // ============================================================================
 
 // Lookup tables from definitions.h
-extern const int16_t sin_fix[25];
-extern const int16_t cos_fix[25];
-extern const int16_t t2_fix4[25];
-
-// Sprite configuration addresses
-extern unsigned SPACECRAFT_CONFIG;
-extern unsigned BULLET_CONFIG;
 
-// Bullet array from main
-extern Bullet bullets[MAX_BULLETS];
+// Player bullet arrays from bullets.c
+extern int16_t bullet_x[MAX_BULLETS];
+extern int16_t bullet_y[MAX_BULLETS];
+extern int8_t bullet_status[MAX_BULLETS];
+extern uint8_t bullet_vx_rem[MAX_BULLETS];
+extern uint8_t bullet_vy_rem[MAX_BULLETS];
+extern sprite_shadow_t bullet_shadow[MAX_BULLETS];
 extern uint8_t current_bullet_index;
 
 // World scrolling state (modified by player movement)
@@ -52,8 +49,11 @@ int16_t player_vy_applied = 0;
 
 // Player internal state
 static int16_t player_vx = 0, player_vy = 0;
-static int16_t player_x_rem = 0, player_y_rem = 0;
+static uint16_t player_x_rem = 0, player_y_rem = 0;
 static int16_t player_rotation = 0;
+
+// Last position and transform written to the ship's config
+static sprite_shadow_t player_shadow;
 static int16_t player_rotation_frame = 0;
 static int16_t player_thrust_x = 0;
 static int16_t player_thrust_y = 0;
@@ -85,7 +85,7 @@ static int death_timer = 0;
  */
 static inline void get_velocity_from_rotation(uint8_t rotation, int16_t* vx_out, int16_t* vy_out)
 {
-    rotation = rotation % SHIP_ROTATION_STEPS;
+    rotation &= SHIP_ROTATION_MASK;
     *vx_out = -sin_fix[rotation];
     *vy_out = -cos_fix[rotation];
 }
@@ -93,13 +93,22 @@ static inline void get_velocity_from_rotation(uint8_t rotation, int16_t* vx_out,
 // Helper: compute minimal signed rotation difference in range (-steps/2, steps/2]
 static inline int rotation_diff(int cur, int tgt)
 {
-    int diff = tgt - cur;
-    int half = SHIP_ROTATION_STEPS / 2;
-    while (diff > half) diff -= SHIP_ROTATION_STEPS;
-    while (diff <= -half) diff += SHIP_ROTATION_STEPS;
+    int diff = (tgt - cur) & SHIP_ROTATION_MASK;
+    if (diff > SHIP_ROTATION_STEPS / 2) diff -= SHIP_ROTATION_STEPS;
     return diff;
 }
 
+// Ship rotation whose thrust (-sin_fix, -cos_fix in screen coordinates)
+// points at the screen center. That is heading_step()'s direction turned
+// back a quarter turn.
+static int rotation_to_centre(void)
+{
+    int16_t dx = SCREEN_WIDTH_D2 - player_x;
+    int16_t dy = player_y - SCREEN_HEIGHT_D2;   // y up
+    uint8_t step = heading_step(dx, dy);
+    return (step + SHIP_ROTATION_STEPS * 3 / 4) & SHIP_ROTATION_MASK;
+}
+
 // ============================================================================
 // PUBLIC FUNCTIONS
 // ============================================================================
@@ -116,6 +125,7 @@ void init_player(void)
     player_y_rem = 0;
     player_rotation = 0;
     player_rotation_frame = 0;
+    sprite_shadow_reset(&player_shadow, 1);
     player_thrust_x = 0;
     player_thrust_y = 0;
     player_thrust_delay = 0;
@@ -132,7 +142,12 @@ void trigger_player_death(void) {
     death_timer = 180; // 3 Seconds @ 60fps
     
     // Hide the player sprite immediately
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, y_pos_px, -100);
+    hide_player_sprite();
+}
+
+void hide_player_sprite(void)
+{
+    asprite_hide(SPACECRAFT_CONFIG, &player_shadow);
 }
 
 void reset_player_position(void)
@@ -145,8 +160,7 @@ void reset_player_position(void)
     player_thrust_y = 0;
     
     // Update sprite position
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, x_pos_px, player_x);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, y_pos_px, player_y);
+    asprite_move(SPACECRAFT_CONFIG, &player_shadow, player_x, player_y);
 }
 
 void update_player(bool demomode)
@@ -170,7 +184,7 @@ void update_player(bool demomode)
 
         // When timer hits 0, trigger the actual Game Over
         if (death_timer <= 0) {
-            enemy_score = 100; // This tells main() to end the game
+            enemy_score = SCORE_TO_WIN; // This tells main() to end the game
         }
         
         return; // Skip movement logic!
@@ -186,23 +200,7 @@ void update_player(bool demomode)
             if (demo_rotate_hold == 0) {
                 // Decide rotation with bias toward steering to screen center.
                 // Compute vector from player to screen center.
-                int16_t cx = SCREEN_WIDTH_D2;
-                int16_t cy = SCREEN_HEIGHT_D2;
-                int32_t dx = (int32_t)cx - (int32_t)player_x;
-                int32_t dy = (int32_t)cy - (int32_t)player_y;
-
-                // Find best rotation index pointing toward center by maximizing dot(thrust_vector, center_vector)
-                int best_rot = 0;
-                int32_t best_dot = INT32_MIN;
-                for (int r = 0; r < SHIP_ROTATION_STEPS; r++) {
-                    int32_t tvx = - (int32_t)sin_fix[r];
-                    int32_t tvy = - (int32_t)cos_fix[r];
-                    int32_t dot = tvx * dx + tvy * dy;
-                    if (dot > best_dot) {
-                        best_dot = dot;
-                        best_rot = r;
-                    }
-                }
+                int best_rot = rotation_to_centre();
 
                 int diff = rotation_diff(player_rotation, best_rot);
 
@@ -245,16 +243,10 @@ void update_player(bool demomode)
         }
         
         if (rotate_left) {
-            player_rotation++;
-            if (player_rotation >= SHIP_ROTATION_STEPS) {
-                player_rotation = 0;
-            }
+            player_rotation = (player_rotation + 1) & SHIP_ROTATION_MASK;
         }
         if (rotate_right) {
-            player_rotation--;
-            if (player_rotation < 0) {
-                player_rotation = SHIP_ROTATION_STEPS - 1;
-            }
+            player_rotation = (player_rotation - 1) & SHIP_ROTATION_MASK;
         }
     }
     
@@ -263,24 +255,15 @@ void update_player(bool demomode)
         // Demo-mode AI for thrust: bias toward thrusting, but throttle
         // when the ship is facing away from the screen center.
         if (demo_thrust_hold == 0) {
-            // Compute vector to screen center
-            int16_t cx = SCREEN_WIDTH_D2;
-            int16_t cy = SCREEN_HEIGHT_D2;
-            int32_t dx = (int32_t)cx - (int32_t)player_x;
-            int32_t dy = (int32_t)cy - (int32_t)player_y;
-
-            // Current facing thrust vector
-            int32_t tvx = - (int32_t)sin_fix[player_rotation];
-            int32_t tvy = - (int32_t)cos_fix[player_rotation];
-
-            // Dot product: positive means facing toward center
-            int64_t dot = (int64_t)tvx * dx + (int64_t)tvy * dy;
+            // Facing toward center means within 90 degrees of it
+            int diff = rotation_diff(player_rotation, rotation_to_centre());
+            int absdiff = diff < 0 ? -diff : diff;
 
             // Base thrust probability
             uint16_t base_prob = 80; // percent
 
             // If facing away from center, reduce probability and shorten holds
-            if (dot <= 0) {
+            if (absdiff >= SHIP_ROTATION_STEPS / 4) {
                 base_prob = 25; // much less likely to thrust when facing away
             }
 
@@ -329,11 +312,8 @@ void update_player(bool demomode)
     int16_t total_vx = player_vx + player_thrust_x;
     int16_t total_vy = player_vy + player_thrust_y;
     
-    player_vx_applied = (total_vx + player_x_rem) >> 9;
-    player_vy_applied = (total_vy + player_y_rem) >> 9;
-    
-    player_x_rem = total_vx + player_x_rem - (player_vx_applied << 9);
-    player_y_rem = total_vy + player_y_rem - (player_vy_applied << 9);
+    player_vx_applied = fx_step16(total_vx, &player_x_rem, PLAYER_VEL_FRAC);
+    player_vy_applied = fx_step16(total_vy, &player_y_rem, PLAYER_VEL_FRAC);
     
     // Apply friction when not thrusting
     if (!thrust) {
@@ -375,32 +355,19 @@ void update_player(bool demomode)
         scroll_dy = new_y - player_y;
     }
 
+    collide_add(CT_PLAYER, 0, player_x + 4, player_y + 4);
+
     // printf("Player position: x=%d, y=%d\n", player_x, player_y);
 }
 
 void update_player_sprite(void)
 {
-    // Update sprite position
-    RIA.step0 = sizeof(vga_mode4_asprite_t);
-    RIA.step1 = sizeof(vga_mode4_asprite_t);
-    RIA.addr0 = SPACECRAFT_CONFIG + 12;
-    RIA.addr1 = SPACECRAFT_CONFIG + 13;
-    
-    RIA.rw0 = player_x & 0xFF;
-    RIA.rw1 = (player_x >> 8) & 0xFF;
-    
-    RIA.addr0 = SPACECRAFT_CONFIG + 14;
-    RIA.addr1 = SPACECRAFT_CONFIG + 15;
-    RIA.rw0 = player_y & 0xFF;
-    RIA.rw1 = (player_y >> 8) & 0xFF;
+    // Position and rotation go through the same queue, so a turning ship
+    // never shows the new transform at the old position or vice versa
+    asprite_move(SPACECRAFT_CONFIG, &player_shadow, player_x, player_y);
     
-    // Update rotation transform matrix
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[0],  cos_fix[player_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[1], -sin_fix[player_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[2],  t2_fix4[player_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[3],  sin_fix[player_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[4],  cos_fix[player_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[5],  t2_fix4[SHIP_ROTATION_MAX - player_rotation + 1]);
+    // Update rotation transform matrix, only uploaded when the ship turned
+    asprite_rotate(SPACECRAFT_CONFIG, &player_shadow, affine_ship, player_rotation);
 }
 
 void fire_bullet(void)
@@ -409,16 +376,16 @@ void fire_bullet(void)
         return;
     }
     
-    if (bullets[current_bullet_index].status < 0) {
-        bullets[current_bullet_index].status = player_rotation;
-        bullets[current_bullet_index].x = player_x + 4;
-        bullets[current_bullet_index].y = player_y + 4;
-        bullets[current_bullet_index].vx_rem = 0;
-        bullets[current_bullet_index].vy_rem = 0;
+    if (bullet_status[current_bullet_index] < 0) {
+        bullet_status[current_bullet_index] = player_rotation;
+        bullet_x[current_bullet_index] = player_x + 4;
+        bullet_y[current_bullet_index] = player_y + 4;
+        bullet_vx_rem[current_bullet_index] = 0;
+        bullet_vy_rem[current_bullet_index] = 0;
         
         unsigned ptr = BULLET_CONFIG + current_bullet_index * sizeof(vga_mode4_sprite_t);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, bullets[current_bullet_index].x);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, bullets[current_bullet_index].y);
+        sprite_move(ptr, &bullet_shadow[current_bullet_index],
+                    bullet_x[current_bullet_index], bullet_y[current_bullet_index]);
         
         play_sound(SFX_TYPE_PLAYER_FIRE, 110, PSG_WAVE_SQUARE, 0, 3, 4, 2);
         
@@ -12,6 +12,11 @@ extern int16_t scroll_dy;
 extern bool player_is_dying;
 void trigger_player_death(void);
 
+/**
+ * Park the player sprite off screen
+ */
+void hide_player_sprite(void);
+
 /**
  * Initialize player state at game start
  */
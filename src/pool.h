@@ -0,0 +1,78 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * pool.h - Fixed entity pools with O(1) spawn and kill
+ *
+ * A pool hands out the indices 0..size-1 of an entity array its module
+ * owns. slot[] holds every index exactly once: the first count are live
+ * (the active list) and the rest are free (the free list, taken from the
+ * front). pos[] maps an index back to its place in slot[], so freeing one
+ * is a swap with the last live slot.
+ *
+ * Per-frame updates walk only the live slots, backwards. That stays
+ * correct when the current slot is freed (whatever is swapped into its
+ * place was already visited) or a new one is spawned (it lands past the
+ * end of the walk):
+ *
+ *     for (uint8_t k = pool.count; k-- > 0; ) {
+ *         uint8_t i = pool.slot[k];
+ *         ...
+ *     }
+ */
+
+// pool_alloc() result when every slot is live
+#define POOL_NONE 0xFF
+
+typedef struct {
+    uint8_t *slot;      // Live indices, then free ones
+    uint8_t *pos;       // Where each index sits in slot[]
+    uint8_t count;      // Live slots
+    uint8_t size;
+} pool_t;
+
+// Define a module-local pool of n slots along with its storage
+#define POOL(name, n) \
+    static uint8_t name##_slot[n]; \
+    static uint8_t name##_pos[n]; \
+    static pool_t name = { name##_slot, name##_pos, 0, (n) }
+
+// Free every slot. The first spawns then get 0, 1, 2, ... in order.
+static inline void pool_reset(pool_t *p)
+{
+    for (uint8_t i = 0; i < p->size; i++) {
+        p->slot[i] = i;
+        p->pos[i] = i;
+    }
+    p->count = 0;
+}
+
+// Take a free slot, or POOL_NONE if the pool is full
+static inline uint8_t pool_alloc(pool_t *p)
+{
+    if (p->count == p->size) return POOL_NONE;
+    return p->slot[p->count++];
+}
+
+static inline bool pool_live(const pool_t *p, uint8_t i)
+{
+    return p->pos[i] < p->count;
+}
+
+// Return slot i to the free list (freeing a free slot does nothing)
+static inline void pool_free(pool_t *p, uint8_t i)
+{
+    uint8_t k = p->pos[i];
+    if (k >= p->count) return;
+
+    uint8_t last = p->slot[--p->count];
+    p->slot[k] = last;
+    p->pos[last] = k;
+    p->slot[p->count] = i;
+    p->pos[i] = p->count;
+}
+
+#endif // POOL_H
@@ -1,20 +1,37 @@
 #include <rp6502.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "constants.h"
 #include "powerup.h"
 #include "player.h"
 #include "sbullets.h"
+#include "collision.h"
+#include "sprite_shadow.h"
 
 powerup_t powerup = { .active = false, .timer = 0 };
 
+// Last position written to the power-up's sprite config
+static sprite_shadow_t powerup_shadow;
+
+void init_powerup(void)
+{
+    powerup.active = false;
+    powerup.timer = 0;
+    sprite_shadow_reset(&powerup_shadow, 1);
+}
+
+void move_powerup_offscreen(void)
+{
+    sprite_hide(POWERUP_CONFIG, &powerup_shadow);
+}
+
 void render_powerup(void)
 {
 
     if (powerup.active == false) {
         return;
     }
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, powerup.x);
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, powerup.y);
+    sprite_move(POWERUP_CONFIG, &powerup_shadow, powerup.x, powerup.y);
 
     return;
 }
@@ -30,29 +47,31 @@ void update_powerup(void)
     powerup.x -= scroll_dx;
     powerup.y -= scroll_dy;
 
-    // Check for collision with player (simple bounding box)
-    if ((powerup.x < player_x + 16) && (powerup.x + 8 > player_x) &&
-        (powerup.y < player_y + 16) && (powerup.y + 8 > player_y)) {
-        // Player collected power-up
+    // Decrease timer
+    powerup.timer--;
+    if (powerup.timer <= 0) {
         powerup.active = false;
         // Move power-up sprite offscreen
-        xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);
-        xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+        move_powerup_offscreen();
+        return;
+    }
 
-        sbullet_cooldown -= SBULLET_COOLDOWN_DECREASE;
-        if (sbullet_cooldown < SBULLET_COOLDOWN_MIN) {
-            sbullet_cooldown = SBULLET_COOLDOWN_MIN;
-        }
+    collide_add(CT_POWERUP, 0, powerup.x + 4, powerup.y + 4);
+}
 
+void collect_powerup(void)
+{
+    if (powerup.active == false) {
         return;
     }
 
-    // Decrease timer
-    powerup.timer--;
-    if (powerup.timer <= 0) {
-        powerup.active = false;
-        // Move power-up sprite offscreen
-        xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);
-        xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+    // Player collected power-up
+    powerup.active = false;
+    // Move power-up sprite offscreen
+    move_powerup_offscreen();
+
+    sbullet_cooldown -= SBULLET_COOLDOWN_DECREASE;
+    if (sbullet_cooldown < SBULLET_COOLDOWN_MIN) {
+        sbullet_cooldown = SBULLET_COOLDOWN_MIN;
     }
 }
@@ -1,13 +1,9 @@
 #ifndef POWERUP_H
 #define POWERUP_H
 
-#define POWERUP_DATA      0xEF40  // 8x8 Sprite Data (128 bytes) Ends at 0xEF00
 #define POWERUP_DURATION_FRAMES  (60 * 5) // Power-up lasts for 5 seconds
 #define POWERUP_DROP_CHANCE_PERCENT 1   // 1% chance to drop a power-up on fighter destruction
 
-// Single storage for the POWERUP_CONFIG symbol is provided in `rpmegafighter.c`.
-extern unsigned POWERUP_CONFIG;        //Power-up sprite config address
-
 // Power-up structure definition
 typedef struct {
 	bool active;
@@ -19,8 +15,19 @@ typedef struct {
 extern powerup_t powerup;
 
 // Function declarations
+
+// Clear the power-up and forget its sprite shadow (after the config image
+// is reloaded)
+void init_powerup(void);
+
+// Park the power-up sprite off screen
+void move_powerup_offscreen(void);
+
 void render_powerup(void);
 
 void update_powerup(void);
 
+// Player touched the power-up (see collision.c)
+void collect_powerup(void);
+
 #endif // POWERUP_H
\ No newline at end of file
@@ -1,5 +1,6 @@
 // #include <rp6502.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include "random.h"
 
 // uint16_t random(uint16_t low_limit, uint16_t high_limit)
@@ -11,22 +12,83 @@
 //     return (uint16_t)((rand() % (high_limit-low_limit)) + low_limit);
 // }
 
-uint16_t lfsr = 0xACE1u; // Do not use 0
+#define RING_MASK (RANDOM_RING_SIZE - 1)
+
+static uint16_t xs_state = 0xACE1u; // Do not use 0
 uint16_t seed_counter = 0;
 
-uint16_t rand16() {
-    // 16-bit Galois LFSR
-    // Polynomial: x^16 + x^14 + x^13 + x^11 + 1
-    unsigned lsb = lfsr & 1;
-    lfsr >>= 1;
-    if (lsb) {
-        lfsr ^= 0xB400u;
+// Bytes generated ahead of use, oldest at ring_head. Readers always take
+// the oldest first, so the stream is the same however much idle time went
+// into filling it.
+static uint8_t ring[RANDOM_RING_SIZE];
+static uint8_t ring_head = 0;
+static uint8_t ring_count = 0;
+
+// 16-bit xorshift, shifts (7, 9, 8): period 65535, and the 9 and 8 bit
+// shifts are byte moves on the 6502
+static uint8_t next_byte(void)
+{
+    xs_state ^= xs_state << 7;
+    xs_state ^= xs_state >> 9;
+    xs_state ^= xs_state << 8;
+    return (uint8_t)xs_state;
+}
+
+void seed_random(uint16_t seed)
+{
+    xs_state = seed ? seed : 0xACE1u;
+    ring_count = 0;
+}
+
+uint16_t random_state(void)
+{
+    ring_count = 0;
+    return xs_state;
+}
+
+bool random_fill(void)
+{
+    for (uint8_t n = 0; n < RANDOM_FILL_BATCH && ring_count < RANDOM_RING_SIZE; n++) {
+        ring[(ring_head + ring_count) & RING_MASK] = next_byte();
+        ring_count++;
     }
-    return lfsr;
+    return ring_count < RANDOM_RING_SIZE;
 }
 
-// Helper to get a number in range [min, max]
+uint8_t rand8(void)
+{
+    if (ring_count == 0) return next_byte();
+
+    uint8_t r = ring[ring_head];
+    ring_head = (ring_head + 1) & RING_MASK;
+    ring_count--;
+    return r;
+}
+
+uint16_t rand16(void)
+{
+    uint16_t lo = rand8();
+    return lo | ((uint16_t)rand8() << 8);
+}
+
+// Helper to get a number in range [min, max]. Draws are masked to the
+// smallest power of two covering the range and redrawn when they land past
+// it (under two draws on average), so there is no division and no bias.
 uint16_t random(uint16_t min, uint16_t max) {
     if (min >= max) return min;
-    return min + (rand16() % (max - min + 1));
-}
\ No newline at end of file
+
+    uint16_t span = max - min;
+    uint16_t mask = span;
+    mask |= mask >> 1;
+    mask |= mask >> 2;
+    mask |= mask >> 4;
+    mask |= mask >> 8;
+
+    uint16_t r;
+    if (mask <= 0xFF) {
+        do r = rand8() & mask; while (r > span);
+    } else {
+        do r = rand16() & mask; while (r > span);
+    }
+    return min + r;
+}
@@ -1,12 +1,31 @@
 // Functions for generating randoms
 #include <stdint.h>
+#include <stdbool.h>
 
 #define swap(a, b) { uint16_t t = a; a = b; b = t; }
 
-// LFSR and seed counter are defined in random.c; declare them here
-extern uint16_t lfsr;
+// Random bytes kept ready by random_fill() (a power of two)
+#define RANDOM_RING_SIZE    32
+// Most bytes one random_fill() call generates
+#define RANDOM_FILL_BATCH   8
+
+// Seed counter is defined in random.c; the title screen ticks it every frame
 extern uint16_t seed_counter;
 
+// Restart the generator from seed (0 is replaced, as the state must never
+// be 0) and drop any prefilled bytes
+void seed_random(uint16_t seed);
+
+// Drop any prefilled bytes and return the generator state; seed_random()
+// with it continues the same stream from here (replays record this)
+uint16_t random_state(void);
+
+// Top up the ring of ready bytes, a few per call (an idle.h job: true
+// while the ring still has room)
+bool random_fill(void);
+
+// Uniform in [low_limit, high_limit], both included
 uint16_t random(uint16_t low_limit, uint16_t high_limit);
 
-uint16_t rand16();
\ No newline at end of file
+uint8_t rand8(void);
+uint16_t rand16(void);
@@ -0,0 +1,240 @@
+#include "replay.h"
+#include "constants.h"
+#include "input.h"
+#include "random.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef INPUT_REPLAY
+
+// ============================================================================
+// EXTERNAL DEPENDENCIES
+// ============================================================================
+
+extern gamepad_t gamepad[GAMEPAD_COUNT];
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+// One frame of input: keystates[] followed by the raw gamepad[] bytes
+#define SNAPSHOT_BYTES (KEYBOARD_BYTES + GAMEPAD_COUNT * sizeof(gamepad_t))
+#define IO_BUF_SIZE 128
+
+static int replay_fd = -1;
+static uint32_t replay_frames = 0;
+
+// Snapshot as of the last record written or read
+static uint8_t snapshot[SNAPSHOT_BYTES];
+static uint8_t run = 0;
+
+static uint8_t io_buf[IO_BUF_SIZE];
+static uint8_t io_len = 0;
+static uint8_t io_pos = 0;
+
+#ifdef INPUT_RECORD
+// Changes that lead into the current run, as index/value pairs
+static uint8_t changes[SNAPSHOT_BYTES * 2];
+static uint8_t nchanges = 0;
+#endif
+
+// ============================================================================
+// SNAPSHOT ACCESS
+// ============================================================================
+
+static uint8_t *input_byte(uint8_t i)
+{
+    if (i < KEYBOARD_BYTES) {
+        return &keystates[i];
+    }
+    return (uint8_t *)gamepad + (i - KEYBOARD_BYTES);
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+#ifdef INPUT_RECORD
+
+static void put_byte(uint8_t b)
+{
+    io_buf[io_len++] = b;
+    if (io_len == IO_BUF_SIZE) {
+        write(replay_fd, io_buf, io_len);
+        io_len = 0;
+    }
+}
+
+static void emit_record(void)
+{
+    put_byte(run);
+    put_byte(nchanges);
+    for (uint8_t i = 0; i < nchanges * 2; i++) {
+        put_byte(changes[i]);
+    }
+}
+
+void replay_start(void)
+{
+    replay_fd = open(REPLAY_FILE, O_WRONLY | O_CREAT | O_TRUNC);
+    if (replay_fd < 0) {
+        printf("Replay: could not create %s\n", REPLAY_FILE);
+        return;
+    }
+    for (uint8_t i = 0; i < SNAPSHOT_BYTES; i++) snapshot[i] = 0;
+    run = 0;
+    nchanges = 0;
+    io_len = 0;
+    replay_frames = 0;
+
+    put_byte('R');
+    put_byte('P');
+    put_byte('L');
+    put_byte('Y');
+    put_byte(REPLAY_VERSION);
+    put_byte(SNAPSHOT_BYTES);
+    uint16_t seed = random_state();
+    put_byte(seed & 0xFF);
+    put_byte(seed >> 8);
+    printf("Replay: recording to %s, seed 0x%04X\n", REPLAY_FILE, seed);
+}
+
+void replay_stop(void)
+{
+    if (replay_fd < 0) return;
+    if (run > 0) emit_record();
+    if (io_len > 0) write(replay_fd, io_buf, io_len);
+    close(replay_fd);
+    replay_fd = -1;
+    printf("Replay: recorded %lu frames\n", (unsigned long)replay_frames);
+}
+
+bool replay_frame(void)
+{
+    if (replay_fd < 0) return false;
+    replay_frames++;
+
+    bool same = true;
+    for (uint8_t i = 0; i < SNAPSHOT_BYTES; i++) {
+        if (*input_byte(i) != snapshot[i]) {
+            same = false;
+            break;
+        }
+    }
+    if (same && run < 255) {
+        run++;
+        return false;
+    }
+
+    // Input changed (or the run is full): close the run and start another
+    if (run > 0) emit_record();
+    nchanges = 0;
+    for (uint8_t i = 0; i < SNAPSHOT_BYTES; i++) {
+        uint8_t b = *input_byte(i);
+        if (b != snapshot[i]) {
+            snapshot[i] = b;
+            changes[nchanges * 2] = i;
+            changes[nchanges * 2 + 1] = b;
+            nchanges++;
+        }
+    }
+    run = 1;
+    return false;
+}
+
+#endif // INPUT_RECORD
+
+// ============================================================================
+// PLAYBACK
+// ============================================================================
+
+#ifdef INPUT_PLAYBACK
+
+// Returns the next byte of the file, or -1 at the end
+static int get_byte(void)
+{
+    if (io_pos == io_len) {
+        int got = read(replay_fd, io_buf, IO_BUF_SIZE);
+        if (got <= 0) return -1;
+        io_len = (uint8_t)got;
+        io_pos = 0;
+    }
+    return io_buf[io_pos++];
+}
+
+void replay_start(void)
+{
+    replay_fd = open(REPLAY_FILE, O_RDONLY);
+    if (replay_fd < 0) {
+        printf("Replay: %s not found, using live input\n", REPLAY_FILE);
+        return;
+    }
+    io_len = io_pos = 0;
+    run = 0;
+    replay_frames = 0;
+    for (uint8_t i = 0; i < SNAPSHOT_BYTES; i++) snapshot[i] = 0;
+
+    uint8_t header[8];
+    for (uint8_t i = 0; i < sizeof(header); i++) {
+        int b = get_byte();
+        header[i] = b < 0 ? 0 : (uint8_t)b;
+    }
+    if (header[0] != 'R' || header[1] != 'P' || header[2] != 'L' || header[3] != 'Y' ||
+        header[4] != REPLAY_VERSION || header[5] != SNAPSHOT_BYTES) {
+        printf("Replay: %s is not a version %d replay\n", REPLAY_FILE, REPLAY_VERSION);
+        close(replay_fd);
+        replay_fd = -1;
+        return;
+    }
+    uint16_t seed = header[6] | (header[7] << 8);
+    seed_random(seed);
+    printf("Replay: playing %s, seed 0x%04X\n", REPLAY_FILE, seed);
+}
+
+void replay_stop(void)
+{
+    if (replay_fd < 0) return;
+    close(replay_fd);
+    replay_fd = -1;
+    printf("Replay: played %lu frames\n", (unsigned long)replay_frames);
+
+    // One recorded game is one benchmark run
+    exit(0);
+}
+
+bool replay_frame(void)
+{
+    if (replay_fd < 0) return false;
+
+    if (run == 0) {
+        int r = get_byte();
+        int n = get_byte();
+        if (r <= 0 || n < 0) {
+            // End of the recording: the benchmark is over
+            replay_stop();
+        }
+        for (uint8_t k = 0; k < n; k++) {
+            int i = get_byte();
+            int b = get_byte();
+            if (i >= 0 && i < (int)SNAPSHOT_BYTES && b >= 0) {
+                snapshot[i] = (uint8_t)b;
+            }
+        }
+        run = (uint8_t)r;
+    }
+    run--;
+    replay_frames++;
+
+    for (uint8_t i = 0; i < SNAPSHOT_BYTES; i++) {
+        *input_byte(i) = snapshot[i];
+    }
+    return true;
+}
+
+#endif // INPUT_PLAYBACK
+
+#endif // INPUT_REPLAY
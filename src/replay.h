@@ -0,0 +1,49 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * replay.h - Deterministic input recording and playback
+ *
+ * ENABLE_INPUT_RECORD (defines INPUT_RECORD) saves every handle_input()
+ * snapshot of a game, plus the random seed it started from, to REPLAY.DAT.
+ * ENABLE_INPUT_PLAYBACK (defines INPUT_PLAYBACK) starts a game straight
+ * from the title screen, restores the seed and feeds the recorded snapshots
+ * back in place of the XRAM input reads, so two builds can be benchmarked
+ * on exactly the same session.
+ *
+ * File layout:
+ *   "RPLY" version(1) snapshot_bytes(1) seed(2, little endian)
+ *   records: run(1) nchanges(1) { index(1) value(1) } * nchanges
+ * Each record patches the previous snapshot (keystates[] then gamepad[])
+ * and holds the result for `run` frames.
+ */
+
+#if defined(INPUT_RECORD) && defined(INPUT_PLAYBACK)
+#error "INPUT_RECORD and INPUT_PLAYBACK are mutually exclusive"
+#endif
+
+#if defined(INPUT_RECORD) || defined(INPUT_PLAYBACK)
+#define INPUT_REPLAY
+
+#define REPLAY_FILE "REPLAY.DAT"
+#define REPLAY_VERSION 2     // 2: xorshift generator
+
+// Open REPLAY.DAT at the start of a game. Recording saves random_state();
+// playback seeds the generator with it.
+void replay_start(void);
+
+// Flush and close REPLAY.DAT at the end of a game. Playback then exits,
+// since one recorded game is one benchmark run.
+void replay_stop(void);
+
+// Called by handle_input() after reading XRAM (record) or instead of it
+// (playback). Playback returns true when it supplied this frame's input.
+// Playback stops the same way when the recording runs out.
+bool replay_frame(void);
+
+#endif // INPUT_RECORD || INPUT_PLAYBACK
+
+#endif // REPLAY_H
@@ -15,6 +15,8 @@
 #include "constants.h"
 #include "definitions.h"
 #include "random.h"
+#include "fixed.h"
+#include "idle.h"
 #include "graphics.h"
 #include "highscore.h"
 #include "hud.h"
@@ -35,28 +37,18 @@
 #include "splash_screen.h"
 #include "asteroids.h"
 #include "explosions.h"
-
-// ============================================================================
-// XRAM MEMORY CONFIGURATION ADDRESSES
-// ============================================================================
-
-unsigned BITMAP_CONFIG;         // Bitmap Config 
-unsigned SPACECRAFT_CONFIG;     // Spacecraft Sprite Config - Affine 
-unsigned EARTH_CONFIG;          // Earth Sprite Config - Standard 
-unsigned ASTEROID_L_CONFIG;     //Asteroid L Sprite Config - Affine
-unsigned STATION_CONFIG;        // Enemy station sprite config
-unsigned BATTLE_CONFIG;         // Enemy battle station sprite config 
-unsigned FIGHTER_CONFIG;        // Enemy fighter sprite config
-unsigned EBULLET_CONFIG;        // Enemy bullet sprite config
-unsigned BULLET_CONFIG;         // Player bullet sprite config
-unsigned SBULLET_CONFIG;        // Super bullet sprite config
-unsigned TEXT_CONFIG;           // On screen text configs
-unsigned text_message_addr;     // Text message address
-unsigned POWERUP_CONFIG;        // Powerup sprite config
-unsigned BOMBER_CONFIG;         // Bomber Sprite (8x8)
-unsigned ASTEROID_M_CONFIG;     // Asteroid M Config
-unsigned ASTEROID_S_CONFIG;     // Asteroid S Config
-unsigned EXPLOSION_CONFIG;      // Explosion sprite configs
+#include "perf_hud.h"
+#include "replay.h"
+#include "stress.h"
+#include "xram_stats.h"
+#include "xram_queue.h"
+#include "xram_config.h"
+#include "collision.h"
+#include "sprite_shadow.h"
+
+#ifdef XRAM_STATS
+uint8_t xram_owner = XS_OTHER;  // Subsystem charged for RIA port traffic
+#endif
 
 // ============================================================================
 // GAME STRUCTURES
@@ -91,10 +83,13 @@ int16_t scroll_dy = 0;
 int16_t earth_x = 0;
 int16_t earth_y = 0;
 
+// Last position written to the Earth's sprite config
+static sprite_shadow_t earth_shadow;
+
 // Scores and game state
-int16_t player_score = 0;
-int16_t enemy_score = 0;
-int16_t game_score = 0;     // Skill-based score
+bcd_t player_score = 0;     // Packed BCD (bcd.h)
+bcd_t enemy_score = 0;
+bcd_t game_score = 0;       // Skill-based score
 int16_t game_level = 1;
 uint16_t game_frame = 0;    // Frame counter (0-59)
 static bool game_over = false;
@@ -111,180 +106,33 @@ extern void update_explosions(void);
 // ============================================================================
 // GRAPHICS INITIALIZATION
 // ============================================================================
+
+/**
+ * Upload the prebuilt config block, parking every sprite offscreen
+ */
+static void load_config_image(void)
+{
+    xram_put_block(VGA_CONFIG_START, xram_config_image, xram_config_size);
+}
+
 static void init_graphics(void) 
 {
-    // Set up bitmap configuration for background (VGA Mode 3)
-    BITMAP_CONFIG = VGA_CONFIG_START;
-    
+    // Port 1 is reserved for the XRAM stream
+    xram_queue_init();
+
+    // Every sprite and text plane config, prebuilt at build time, in one
+    // streamed copy (xram_config.h)
+    load_config_image();
+
     // Set 320x180 canvas
     xregn(1, 0, 0, 1, 2);
     
-    // Configure bitmap parameters
-    xram0_struct_set(BITMAP_CONFIG, vga_mode3_config_t, x_pos_px, 0);
-    xram0_struct_set(BITMAP_CONFIG, vga_mode3_config_t, y_pos_px, 0);
-    xram0_struct_set(BITMAP_CONFIG, vga_mode3_config_t, width_px, 320);
-    xram0_struct_set(BITMAP_CONFIG, vga_mode3_config_t, height_px, 180);
-    xram0_struct_set(BITMAP_CONFIG, vga_mode3_config_t, xram_data_ptr, 0);
-    xram0_struct_set(BITMAP_CONFIG, vga_mode3_config_t, xram_palette_ptr, 0xF000); // 0xFFFF);
-    
     // Enable Mode 3 bitmap (4-bit color)
     xregn(1, 0, 1, 4, 3, 3, BITMAP_CONFIG, 1);
     
-    // Set up player spacecraft sprite (VGA Mode 4 - affine sprite with rotation)
-    SPACECRAFT_CONFIG = BITMAP_CONFIG + sizeof(vga_mode3_config_t);
-    
-    // Initialize rotation transform matrix (identity at rotation 0)
-    int16_t initial_rotation = get_player_rotation();
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[0],  cos_fix[initial_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[1], -sin_fix[initial_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[2],  t2_fix4[initial_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[3],  sin_fix[initial_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[4],  cos_fix[initial_rotation]);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, transform[5],  t2_fix4[SHIP_ROTATION_MAX - initial_rotation + 1]);
-    
-    // Set sprite position and properties
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, x_pos_px, -100); //player_x);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, y_pos_px, -100); //player_y);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, xram_sprite_ptr, SPACESHIP_DATA);
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, log_size, 3);  // 8x8 sprite (2^3)
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, has_opacity_metadata, false);
-
-    // Set up Asteroid L sprite (VGA Mode 4 - affine sprite)
-    ASTEROID_L_CONFIG = SPACECRAFT_CONFIG + sizeof(vga_mode4_asprite_t);
-
-    for (uint8_t i = 0; i < COUNT_ASTEROID_L; i++) {
-        unsigned ptr = ASTEROID_L_CONFIG + i * sizeof(vga_mode4_asprite_t);
-
-        // Set identity transform with proper centering for 16x16 sprite
-        // For no rotation: cos=256 (1.0), sin=0, offsets center the 16x16 sprite
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[0], 0x0100);  // cos = 1.0
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[1], 0);  // -sin = 0
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[2], 0);  //
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[3], 0);  // sin = 0
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[4], 0x0100);  // cos = 1.0
-        xram0_struct_set(ptr, vga_mode4_asprite_t, transform[5], 0);  // 
-
-        // Set sprite position and properties
-        xram0_struct_set(ptr, vga_mode4_asprite_t, x_pos_px, -100); // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_asprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_asprite_t, xram_sprite_ptr, ASTEROID_L_DATA);
-        xram0_struct_set(ptr, vga_mode4_asprite_t, log_size, 5);  // 32x32 sprite (2^5)
-        xram0_struct_set(ptr, vga_mode4_asprite_t, has_opacity_metadata, false);
-    }
-
-    // Set up Earth background sprite (VGA Mode 4 - regular sprite)
-    EARTH_CONFIG = ASTEROID_L_CONFIG + COUNT_ASTEROID_L * sizeof(vga_mode4_asprite_t);
-    
-    // Initialize Earth sprite centered on screen
+    // Earth starts centered on screen
     earth_x = SCREEN_WIDTH / 2;
     earth_y = SCREEN_HEIGHT / 2;
-    
-    xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, x_pos_px, earth_x);
-    xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, y_pos_px, earth_y);
-    xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, xram_sprite_ptr, EARTH_DATA);
-    xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, log_size, 5);  // 32x32 sprite (2^5)
-    xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, has_opacity_metadata, false);
-
-    // Set up fighter sprites (VGA Mode 4 - regular sprites)
-    FIGHTER_CONFIG = EARTH_CONFIG +  sizeof(vga_mode4_sprite_t);
-
-    for (uint8_t i = 0; i < MAX_FIGHTERS; i++) {
-        unsigned ptr = FIGHTER_CONFIG + i * sizeof(vga_mode4_sprite_t);
-        
-        // Initialize sprite configuration
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, FIGHTER_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 2);  // 4x4 sprite (2^2)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
-    }
-    
-    // Set up enemy bullet sprites (VGA Mode 4 - regular sprites)
-    EBULLET_CONFIG = FIGHTER_CONFIG + MAX_FIGHTERS * sizeof(vga_mode4_sprite_t);
-    
-    for (uint8_t i = 0; i < MAX_EBULLETS; i++) {
-        unsigned ptr = EBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-        
-        // Initialize sprite configuration  
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, EBULLET_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 1);  // 2x2 sprite (2^1)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);  // Match fighter config
-    }
-    
-    // Set up player bullet sprites (VGA Mode 4 - regular sprites)
-    BULLET_CONFIG = EBULLET_CONFIG + MAX_EBULLETS * sizeof(vga_mode4_sprite_t);
-    
-    for (uint8_t i = 0; i < MAX_BULLETS; i++) {
-        unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-        
-        // Initialize sprite configuration  
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, BULLET_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 1);  // 2x2 sprite (2^1)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
-    }
-    
-    // Set up super bullet sprites (VGA Mode 4 - regular sprites)
-    SBULLET_CONFIG = BULLET_CONFIG + MAX_BULLETS * sizeof(vga_mode4_sprite_t);
-    
-    for (uint8_t i = 0; i < MAX_SBULLETS; i++) {
-        unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-        
-        // Initialize sprite configuration  
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, SBULLET_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 2);  // 4x4 sprite (2^2)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
-    }
-
-    // Initialize power-up sprite (VGA Mode 4 - regular sprite)
-    POWERUP_CONFIG = SBULLET_CONFIG + MAX_SBULLETS * sizeof(vga_mode4_sprite_t);
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, xram_sprite_ptr, POWERUP_DATA);
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, log_size, 3);  // 8x8 sprite (2^3)
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, has_opacity_metadata, false);
-
-    BOMBER_CONFIG = POWERUP_CONFIG + sizeof(vga_mode4_sprite_t);
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, xram_sprite_ptr, BOMBER_DATA);
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, log_size, 3);  // 8x8 sprite (2^3)
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, has_opacity_metadata, false);
-
-    ASTEROID_M_CONFIG = BOMBER_CONFIG + sizeof(vga_mode4_sprite_t);
-    for (uint8_t i = 0; i < COUNT_ASTEROID_M; i++) {
-        unsigned ptr = ASTEROID_M_CONFIG + i * sizeof(vga_mode4_sprite_t);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, ASTEROID_M_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 4);  // 16x16 sprite (2^4)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
-    }
-        
-    ASTEROID_S_CONFIG = ASTEROID_M_CONFIG + COUNT_ASTEROID_M * sizeof(vga_mode4_sprite_t);
-    for (uint8_t i = 0; i < COUNT_ASTEROID_S; i++) {
-        unsigned ptr = ASTEROID_S_CONFIG + i * sizeof(vga_mode4_sprite_t);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, ASTEROID_S_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 3);  // 8x8 sprite (2^3)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
-    }
-
-    EXPLOSION_CONFIG = ASTEROID_S_CONFIG + COUNT_ASTEROID_S * sizeof(vga_mode4_sprite_t);
-    for (uint8_t i = 0; i < MAX_EXPLOSIONS; i++) {
-        unsigned ptr = EXPLOSION_CONFIG + i * sizeof(vga_mode4_sprite_t);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);  // Start offscreen
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, xram_sprite_ptr, EXPLOSION_DATA);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, log_size, 4);  // 16x16 sprite (2^4)
-        xram0_struct_set(ptr, vga_mode4_sprite_t, has_opacity_metadata, false);
-    }
 
     // Enable sprite modes:
     // Then enable affine sprites (player) - 1 sprite at SPACECRAFT_CONFIG
@@ -295,62 +143,7 @@ static void init_graphics(void)
     xregn(1, 0, 1, 5, 4, 0, FIGHTER_CONFIG, MAX_FIGHTERS + MAX_EBULLETS + MAX_BULLETS + 
         MAX_SBULLETS + 2 + COUNT_ASTEROID_M + COUNT_ASTEROID_S + MAX_EXPLOSIONS, 1);
 
-
-
-    // xregn(1, 0, 1, 6, 
-    //   3, BITMAP_CONFIG, 
-    //   4, SPACECRAFT_CONFIG, 
-    //   4, EARTH_CONFIG
-    // );
-
     // Enable text mode for on-screen messages
-
-    TEXT_CONFIG = EXPLOSION_CONFIG + MAX_EXPLOSIONS * sizeof(vga_mode4_sprite_t); // 0xEC32; //Config address for text mode
-    // Place text message data immediately after text config entries
-    text_message_addr = TEXT_CONFIG + NTEXT * sizeof(vga_mode1_config_t); // 0xEC42; // address to store text message
-
-    // Debug: print config addresses and sizes to help diagnose overlaps
-    printf("Config addresses:\n");
-    printf("  BITMAP_CONFIG=0x%X\n", BITMAP_CONFIG);
-    printf("  SPACECRAFT_CONFIG=0x%X\n", SPACECRAFT_CONFIG);
-    printf("  ASTEROID_L_CONFIG=0x%X\n", ASTEROID_L_CONFIG);
-    printf("  EARTH_CONFIG=0x%X\n", EARTH_CONFIG);
-    printf("  FIGHTER_CONFIG=0x%X\n", FIGHTER_CONFIG);
-    printf("  EBULLET_CONFIG=0x%X\n", EBULLET_CONFIG);
-    printf("  BULLET_CONFIG=0x%X\n", BULLET_CONFIG);
-    printf("  SBULLET_CONFIG=0x%X\n", SBULLET_CONFIG);
-    printf("  POWERUP_CONFIG=0x%X\n", POWERUP_CONFIG);
-    printf("  BOMBER_CONFIG=0x%X\n", BOMBER_CONFIG);
-    printf("  ASTEROID_M_CONFIG=0x%X\n", ASTEROID_M_CONFIG);
-    printf("  ASTEROID_S_CONFIG=0x%X\n", ASTEROID_S_CONFIG);
-    printf("  TEXT_CONFIG=0x%X\n", TEXT_CONFIG);
-    printf("  text_message_addr=0x%X\n", text_message_addr);
-    // Calculate and print end of text storage (MESSAGE_LENGTH * bytes_per_char)
-    const unsigned bytes_per_char = 3; // we write 3 bytes per character into text RAM
-    unsigned text_storage_end = text_message_addr + MESSAGE_LENGTH * bytes_per_char;
-    printf("  text_storage_end=0x%X\n", text_storage_end);
-    printf("  GAME_PAD_CONFIG=0x%X\n", GAMEPAD_INPUT);
-    printf("  KEYBOARD_CONFIG=0x%X\n", KEYBOARD_INPUT);
-    printf("  PSG_CONFIG=0x%X\n", PSG_XRAM_ADDR);
-
-    // printf("Struct sizes: vga_mode4_sprite_t=%u, vga_mode1_config_t=%u\n", (unsigned)sizeof(vga_mode4_sprite_t), (unsigned)sizeof(vga_mode1_config_t));
-
-
-    for (uint8_t i = 0; i < NTEXT; i++) {
-
-        unsigned ptr = TEXT_CONFIG + i * sizeof(vga_mode1_config_t);
-
-        xram0_struct_set(ptr, vga_mode1_config_t, x_wrap, 0);
-        xram0_struct_set(ptr, vga_mode1_config_t, y_wrap, 0);
-        xram0_struct_set(ptr, vga_mode1_config_t, x_pos_px, 7); //Bug: first char duplicated if not set to zero
-        xram0_struct_set(ptr, vga_mode1_config_t, y_pos_px, 1);
-        xram0_struct_set(ptr, vga_mode1_config_t, width_chars, MESSAGE_WIDTH);
-        xram0_struct_set(ptr, vga_mode1_config_t, height_chars, MESSAGE_HEIGHT);
-        xram0_struct_set(ptr, vga_mode1_config_t, xram_data_ptr, text_message_addr);
-        xram0_struct_set(ptr, vga_mode1_config_t, xram_palette_ptr, 0xFFFF);
-        xram0_struct_set(ptr, vga_mode1_config_t, xram_font_ptr, 0xFFFF);
-    }
-
     // 4 parameters: text mode, 8-bit, config, plane
     xregn(1, 0, 1, 4, 1, 3, TEXT_CONFIG, 2);
 
@@ -369,11 +162,11 @@ static void init_graphics(void)
     char enemy_buf[4] = "000";
     char level_buf[3] = "01";   // 2 char + NUL
 
-    // Ensure scores are in range and format zero-padded
-    snprintf(player_buf, sizeof(player_buf), "%03d", player_score >= 0 ? player_score : 0);
-    snprintf(game_buf, sizeof(game_buf), "%05d", game_score >= 0 ? game_score : 0);
-    snprintf(enemy_buf, sizeof(enemy_buf), "%03d", enemy_score >= 0 ? enemy_score : 0);
-    snprintf(level_buf, sizeof(level_buf), "%02d", game_level >= 1 ? game_level : 1);
+    // Zero-padded digits straight from the BCD nibbles
+    bcd_digits(player_buf, player_score, 3);
+    bcd_digits(game_buf, game_score, 5);
+    bcd_digits(enemy_buf, enemy_score, 3);
+    bcd_digits(level_buf, bcd_from_u8(game_level >= 1 ? game_level : 1), 2);
 
     int idx = left_pad;
     // player 3 chars
@@ -405,7 +198,7 @@ static void init_graphics(void)
     // printf("Full message: '%.*s'\n", MESSAGE_LENGTH, message);
 
     // Now write the MESSAGE_LENGTH characters into text RAM (3 bytes per char)
-    RIA.addr0 = text_message_addr;
+    RIA.addr0 = TEXT_MESSAGE_DATA;
     RIA.step0 = 1;
     for (uint8_t i = 0; i < MESSAGE_LENGTH; i++) {
         // block1 region
@@ -452,7 +245,14 @@ static void init_game(void)
     reset_fighter_difficulty();  // Reset fighter difficulty to initial values
     reset_music_tempo();  // Reset music tempo to default
     game_over = false;
+#ifdef PERF_HUD
+    perf_hud_reset();
+#endif
     
+    // Restore every sprite config in one copy; the pools below start
+    // from parked sprites and forget what their shadows held
+    load_config_image();
+
     // Reset player position and state
     init_player();
     
@@ -463,17 +263,16 @@ static void init_game(void)
     init_asteroids();
     init_stars();
     init_explosions();
+    init_collisions();
 
     // Reset Earth position
     earth_x = SCREEN_WIDTH / 2;
     earth_y = SCREEN_HEIGHT / 2;
+    sprite_shadow_reset(&earth_shadow, 1);
 
-    // Reset power-up state
-    powerup.active = false;
-    powerup.timer = 0;
-    // If not already, move power-up sprite offscreen
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+    // Reset power-up and bomber state (the config image parks their sprites)
+    init_powerup();
+    init_bomber();
 
     printf("Game initialized\n");
 }
@@ -481,27 +280,36 @@ static void init_game(void)
 // ============================================================================
 // RENDERING
 // ============================================================================
-void render_game(void)
+/**
+ * Draw the frame
+ * @param dx, dy scroll since the last render (more than one step's worth
+ *        when FIXED_TIMESTEP skipped renders to catch up)
+ */
+PROFILED void render_game(int16_t dx, int16_t dy)
 {
     // Draw scrolling star background
-    draw_stars(scroll_dx, scroll_dy);
+    XRAM_OWNER(XS_STARS);
+    draw_stars(dx, dy);
     
     // Update Earth sprite position based on scrolling with wrapping
-    earth_x -= scroll_dx;
-    earth_y -= scroll_dy;
+    earth_x -= dx;
+    earth_y -= dy;
     
-    xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, x_pos_px, earth_x);
-    xram0_struct_set(EARTH_CONFIG, vga_mode4_sprite_t, y_pos_px, earth_y);
+    XRAM_OWNER(XS_OTHER);
+    sprite_move(EARTH_CONFIG, &earth_shadow, earth_x, earth_y);
     
     // Update fighter sprite positions
+    XRAM_OWNER(XS_FIGHTERS);
     render_fighters();
     
     // Bullets are drawn in update_bullets() and update_ebullets()
     
     // Update player sprite on screen
+    XRAM_OWNER(XS_PLAYER);
     update_player_sprite();
 
     // Update power-up sprite if active
+    XRAM_OWNER(XS_OTHER);
     render_powerup();
 
 }
@@ -509,11 +317,11 @@ void render_game(void)
 void hide_all_sprites(void)
 {
     // 1. Hide Player
-    xram0_struct_set(SPACECRAFT_CONFIG, vga_mode4_asprite_t, y_pos_px, -100);
+    hide_player_sprite();
 
     // 2. Hide Special Objects
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
-    xram0_struct_set(BOMBER_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+    move_powerup_offscreen();
+    move_bomber_offscreen();
     // xram0_struct_set(MARKER_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
 
     // 3. Hide Swarms
@@ -525,12 +333,8 @@ void hide_all_sprites(void)
     move_sbullets_offscreen();
     move_asteroids_offscreen();
 
-    // 4. Hide Player Bullets (Manual loop just in case)
-    size_t sprite_size = sizeof(vga_mode4_sprite_t);
-    for (uint8_t i = 0; i < MAX_BULLETS; i++) {
-        unsigned ptr = BULLET_CONFIG + (i * sprite_size);
-        xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-    }
+    // 4. Hide Player Bullets
+    move_bullets_offscreen();
 
     // Reset Earth position
     earth_x = SCREEN_WIDTH / 2;
@@ -544,6 +348,12 @@ void hide_all_sprites(void)
 // MAIN GAME LOOP
 // ============================================================================
 
+#ifdef FIXED_TIMESTEP
+// Most simulation steps run per wake-up. A longer stall (a run of very slow
+// frames) is dropped rather than caught up: the game runs a single step.
+#define MAX_STEPS_PER_FRAME 4
+#endif
+
 // Demo mode parameters
 bool demo_mode_active = false;
 uint16_t demo_frames = 0;
@@ -560,6 +370,7 @@ int main(void)
     
     // Initialize systems (one time only)
     init_graphics();
+    init_fixed();
     init_psg();
     init_music();
     
@@ -594,6 +405,13 @@ int main(void)
         // Show title screen and wait for START
         show_title_screen();
 
+    #ifdef INPUT_REPLAY
+        // Record or play back real games only, never the attract-mode demo
+        if (!demo_mode_active) {
+            replay_start();
+        }
+    #endif
+
         // Reset demo mode counter
         if (demo_mode_active) {
             demo_frames = 0;
@@ -605,19 +423,63 @@ int main(void)
         // Start gameplay music
         start_gameplay_music();
         
+    #ifdef STRESS_TEST
+        stress_start();
+    #endif
+
         printf("Starting game loop...\n\n");
         
         // Gameplay loop
+        xram_queue_begin();
         game_over = false;
         bool demo_input_was_pressed = false;
         // uint16_t game_frame = 0;
+
+        // Each pass of the loop is one simulation step. Normally there is
+        // one per vsync. FIXED_TIMESTEP builds run one per vsync that has
+        // passed, so the game keeps real-time speed when a frame overruns,
+        // and render only on the last of them.
+        uint8_t steps_due = 0;
+        int16_t render_dx = 0, render_dy = 0;   // Scroll not yet drawn
+        vsync_last = RIA.vsync;                 // Title screen time is not caught up
         while (!game_over) {
-            // Wait for vertical sync (60 Hz)
-            if (RIA.vsync == vsync_last)
-                continue;
-            vsync_last = RIA.vsync;
+            if (steps_due == 0) {
+                // Wait for vertical sync (60 Hz). Sample it once so a tick
+                // landing mid-update is counted next time rather than lost.
+                uint8_t vsync_now = RIA.vsync;
+                if (vsync_now == vsync_last) {
+                #ifdef STRESS_TEST
+                    stress_idle_polls++;
+                #endif
+                    idle_run(vsync_last);
+                    continue;
+                }
+                uint8_t elapsed = vsync_now - vsync_last;
+            #ifdef PERF_HUD
+                perf_hud_frame(elapsed);
+            #endif
+            #ifdef STRESS_TEST
+                stress_frame(elapsed);
+            #endif
+                vsync_last = vsync_now;
+            #ifdef FIXED_TIMESTEP
+                steps_due = (elapsed > MAX_STEPS_PER_FRAME) ? 1 : elapsed;
+            #else
+                (void)elapsed;
+                steps_due = 1;
+            #endif
+
+                // Upload last frame's sprite, HUD and sound writes during blanking
+                xram_queue_flush();
+
+                // Top up the random bytes in this frame's spare time, ready for
+                // spawn-heavy frames
+                idle_post(random_fill);
+            }
+            steps_due--;
 
             // Read input
+            XRAM_OWNER(XS_INPUT);
             handle_input(); 
 
             // This prevents the START button from freezing the game during the demo
@@ -686,10 +548,12 @@ int main(void)
                     stop_music();
                     break;
                 }
+                steps_due = 0;  // Paused time is not caught up
                 continue;
             }
             
             // Update music
+            XRAM_OWNER(XS_SOUND);
             update_music();
             
             // Update cooldown timers
@@ -697,43 +561,66 @@ int main(void)
             decrement_ebullet_cooldown();
 
             // Enemy bullet system
+            XRAM_OWNER(XS_EBULLETS);
             fire_ebullet();
             
             // Handle player fire buttons
             // Regular bullets: keyboard SPACE or gamepad A button (0x01)
             // if (is_action_pressed(0, ACTION_FIRE) || (demo_mode_active)) {
             if (!player_is_dying && (is_action_pressed(0, ACTION_FIRE) || demo_mode_active)) {
+                XRAM_OWNER(XS_BULLETS);
                 fire_bullet();
             }
             
             // Super bullets: keyboard Left Shift or gamepad X button (0x08)
             // if (is_action_pressed(0, ACTION_SUPER_FIRE) || (demo_mode_active)) {
             if (!player_is_dying && (is_action_pressed(0, ACTION_SUPER_FIRE) || demo_mode_active)) {
+                XRAM_OWNER(XS_SBULLETS);
                 fire_sbullet(get_player_rotation());
             }
             
-            // Update game logic
+            // Update game logic; each update registers its live entities
+            // for the collision pass below
+            collide_begin();
+            XRAM_OWNER(XS_PLAYER);
             update_player(demo_mode_active);
+            XRAM_OWNER(XS_FIGHTERS);
             update_fighters();
+            XRAM_OWNER(XS_BULLETS);
             update_bullets();
+            XRAM_OWNER(XS_SBULLETS);
             update_sbullets();
+            XRAM_OWNER(XS_EBULLETS);
             update_ebullets();
             // update_bomber();
+            XRAM_OWNER(XS_ASTEROIDS);
             spawn_asteroid_wave(game_level);
             update_asteroids();
+            XRAM_OWNER(XS_EXPLOSIONS);
             update_explosions();
 
-            // Only check if playing (not demo) and not already game over
-            if (!demo_mode_active && !game_over) {
-                check_player_asteroid_collision(player_x, player_y);
-            }
-
             // Update scrolling based on player movement
+            XRAM_OWNER(XS_OTHER);
             update_powerup();
+
+            // One sweep over everything registered above. The player only
+            // crashes into asteroids when playing (not demo) and not
+            // already game over.
+            XRAM_OWNER(XS_COLLISIONS);
+            run_collisions(!demo_mode_active && !game_over);
+            XRAM_OWNER(XS_OTHER);
             
-            // Render frame
-            render_game();
-            draw_hud();
+            // Render frame, after the last step due this vsync
+            render_dx += scroll_dx;
+            render_dy += scroll_dy;
+            if (steps_due == 0) {
+                render_game(render_dx, render_dy);
+                render_dx = 0;
+                render_dy = 0;
+                XRAM_OWNER(XS_HUD);
+                draw_hud();
+                XRAM_OWNER(XS_OTHER);
+            }
 
             // Demo Overlay Rendering (Kept at bottom to draw on top)
             if (demo_mode_active) {
@@ -777,8 +664,15 @@ int main(void)
                 // Speed up the music
                 increase_music_tempo();
                 
-                // Show level up screen
+                // Show level up screen. It draws and plays music with
+                // xram_put() while blocking, so write through until it returns.
+                xram_queue_end();
                 show_level_up();
+                xram_queue_begin();
+
+                // Time spent on the screen is not caught up
+                vsync_last = RIA.vsync;
+                steps_due = 0;
                 
                 // Reset scores for next level
                 player_score = 0;
@@ -793,13 +687,22 @@ int main(void)
                 stop_music();  // Stop gameplay music
                 reset_music_tempo();  // Reset tempo for next game
                 init_explosions(); // Re-initialize explosions for game over effect
+                xram_queue_end();
                 show_game_over();
+                xram_queue_begin();
+                vsync_last = RIA.vsync;
+                steps_due = 0;
                 
                 // Set flag to exit gameplay loop and return to title screen
                 game_over = true;
             }
         }
     // Gameplay loop ended - will return to title screen
+        xram_queue_end();
+        XRAM_OWNER(XS_OTHER);
+    #ifdef INPUT_REPLAY
+        replay_stop();
+    #endif
         hide_all_sprites();
         printf("Game/Demo Finished. Resetting...\n");
     }
@@ -807,7 +710,7 @@ int main(void)
     // Should never reach here unless ESC pressed
     printf("\nExiting game...\n");
     printf("Final Level: %d\n", game_level);
-    printf("Final Score: %d\n", game_score);
+    printf("Final Score: %lX\n", (unsigned long)game_score);  // BCD prints as hex
     
     return 0;
 }
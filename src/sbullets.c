@@ -1,6 +1,10 @@
 #include "sbullets.h"
 #include "constants.h"
 #include "sound.h"
+#include "sprite_shadow.h"
+#include "collision.h"
+#include "trig_tables.h"
+#include "fixed.h"
 #include <rp6502.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -18,30 +22,23 @@
 // EXTERNAL DEPENDENCIES
 // ============================================================================
 
-// Game state from main
-extern int16_t player_score;
-extern int16_t game_score;
-
 // Player position
 extern int16_t player_x;
 extern int16_t player_y;
 
-// Sprite configuration addresses
-extern unsigned SBULLET_CONFIG;
-
 // Lookup tables from definitions.h
-extern const int16_t sin_fix[25];
-extern const int16_t cos_fix[25];
-
-// Collision check from fighters module
-extern bool check_bullet_fighter_collision(int16_t bullet_x, int16_t bullet_y,
-                                          int16_t* player_score_out, int16_t* game_score_out);
 
 // ============================================================================
 // MODULE STATE
 // ============================================================================
 
-static SBullet sbullets[MAX_SBULLETS];
+// Super bullets, one array per field
+static int16_t sbullet_x[MAX_SBULLETS];
+static int16_t sbullet_y[MAX_SBULLETS];
+static int8_t sbullet_status[MAX_SBULLETS];     // -1 = inactive, else direction step
+static uint8_t sbullet_vx_rem[MAX_SBULLETS];    // Sub-pixel remainders, 0-63
+static uint8_t sbullet_vy_rem[MAX_SBULLETS];
+static sprite_shadow_t sbullet_shadow[MAX_SBULLETS];
 static uint16_t sbullet_cooldown_timer = 0;
 static int16_t sbullet_lifetime_timer = 0;
 
@@ -55,23 +52,24 @@ int16_t sbullet_cooldown;
 void move_sbullets_offscreen(void)
 {
     for (uint8_t i = 0; i < MAX_SBULLETS; i++) {
-        if (sbullets[i].status >= 0) {
-            sbullets[i].status = -1;
+        if (sbullet_status[i] >= 0) {
+            sbullet_status[i] = -1;
             unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_hide(ptr, &sbullet_shadow[i]);
         }
     }
 }
 
 void init_sbullets(void)
 {
+    sprite_shadow_reset(sbullet_shadow, MAX_SBULLETS);
+
     for (uint8_t i = 0; i < MAX_SBULLETS; i++) {
-        sbullets[i].status = -1;
-        sbullets[i].x = 0;
-        sbullets[i].y = 0;
-        sbullets[i].vx_rem = 0;
-        sbullets[i].vy_rem = 0;
+        sbullet_status[i] = -1;
+        sbullet_x[i] = 0;
+        sbullet_y[i] = 0;
+        sbullet_vx_rem[i] = 0;
+        sbullet_vy_rem[i] = 0;
     }
     sbullet_cooldown_timer = 0;
     sbullet_cooldown = SBULLET_COOLDOWN_MAX; // Initialize cooldown
@@ -86,7 +84,7 @@ bool fire_sbullet(uint8_t player_rotation)
     }
     
     // Check if all 3 bullets are available
-    // if (sbullets[0].status >= 0 || sbullets[1].status >= 0 || sbullets[2].status >= 0) {
+    // if (sbullet_status[0] >= 0 || sbullet_status[1] >= 0 || sbullet_status[2] >= 0) {
     //     return false;
     // }
     
@@ -101,31 +99,25 @@ bool fire_sbullet(uint8_t player_rotation)
     int16_t start_y = player_y + 2;
     
     // Left bullet (rotation - 1)
-    sbullets[0].status = player_rotation - 1;
-    if (sbullets[0].status < 0) {
-        sbullets[0].status = SHIP_ROTATION_STEPS - 1;
-    }
-    sbullets[0].x = start_x;
-    sbullets[0].y = start_y;
-    sbullets[0].vx_rem = 0;
-    sbullets[0].vy_rem = 0;
+    sbullet_status[0] = (player_rotation - 1) & SHIP_ROTATION_MASK;
+    sbullet_x[0] = start_x;
+    sbullet_y[0] = start_y;
+    sbullet_vx_rem[0] = 0;
+    sbullet_vy_rem[0] = 0;
     
     // Center bullet (player rotation)
-    sbullets[1].status = player_rotation;
-    sbullets[1].x = start_x;
-    sbullets[1].y = start_y;
-    sbullets[1].vx_rem = 0;
-    sbullets[1].vy_rem = 0;
+    sbullet_status[1] = player_rotation;
+    sbullet_x[1] = start_x;
+    sbullet_y[1] = start_y;
+    sbullet_vx_rem[1] = 0;
+    sbullet_vy_rem[1] = 0;
     
     // Right bullet (rotation + 1)
-    sbullets[2].status = player_rotation + 1;
-    if (sbullets[2].status >= SHIP_ROTATION_STEPS) {
-        sbullets[2].status = 0;
-    }
-    sbullets[2].x = start_x;
-    sbullets[2].y = start_y;
-    sbullets[2].vx_rem = 0;
-    sbullets[2].vy_rem = 0;
+    sbullet_status[2] = (player_rotation + 1) & SHIP_ROTATION_MASK;
+    sbullet_x[2] = start_x;
+    sbullet_y[2] = start_y;
+    sbullet_vx_rem[2] = 0;
+    sbullet_vy_rem[2] = 0;
     
     // Play sound effect
     play_sound(SFX_TYPE_PLAYER_FIRE, 880, PSG_WAVE_SQUARE, 0, 3, 2, 3);
@@ -150,11 +142,10 @@ void update_sbullets(void)
     } else {
         // Lifetime expired - deactivate all bullets
         for (uint8_t i = 0; i < MAX_SBULLETS; i++) {
-            if (sbullets[i].status >= 0) {
-                sbullets[i].status = -1;
+            if (sbullet_status[i] >= 0) {
+                sbullet_status[i] = -1;
                 unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-                xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-                xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+                sprite_hide(ptr, &sbullet_shadow[i]);
             }
         }
         sbullet_lifetime_timer = 0;
@@ -162,52 +153,42 @@ void update_sbullets(void)
     }
     
     for (uint8_t i = 0; i < MAX_SBULLETS; i++) {
-        if (sbullets[i].status < 0) {
+        if (sbullet_status[i] < 0) {
             // Move sprite offscreen when inactive
             unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-            continue;
-        }
-        
-        // Check collision with fighters before moving
-        if (check_bullet_fighter_collision(sbullets[i].x, sbullets[i].y, &player_score, &game_score)) {
-            // Hit a fighter - deactivate bullet
-            // sbullets[i].status = -1;
-            // unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            // xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            // xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_hide(ptr, &sbullet_shadow[i]);
             continue;
         }
         
         // Calculate velocity based on stored direction
-        int16_t bvx_req = -sin_fix[sbullets[i].status];
-        int16_t bvy_req = -cos_fix[sbullets[i].status];
+        int16_t bvx_req = -sin_fix[sbullet_status[i]];
+        int16_t bvy_req = -cos_fix[sbullet_status[i]];
         
         // Apply velocity with remainder tracking (>>6 = divide by 64)
-        int16_t bvx_applied = (bvx_req + sbullets[i].vx_rem) >> SBULLET_SPEED_SHIFT;
-        int16_t bvy_applied = (bvy_req + sbullets[i].vy_rem) >> SBULLET_SPEED_SHIFT;
-        
-        sbullets[i].vx_rem = bvx_req + sbullets[i].vx_rem - (bvx_applied << SBULLET_SPEED_SHIFT);
-        sbullets[i].vy_rem = bvy_req + sbullets[i].vy_rem - (bvy_applied << SBULLET_SPEED_SHIFT);
+        int16_t bvx_applied = fx_step8(bvx_req, &sbullet_vx_rem[i], SBULLET_SPEED_SHIFT);
+        int16_t bvy_applied = fx_step8(bvy_req, &sbullet_vy_rem[i], SBULLET_SPEED_SHIFT);
         
         // Move bullet
-        sbullets[i].x += bvx_applied;
-        sbullets[i].y += bvy_applied;
+        sbullet_x[i] += bvx_applied;
+        sbullet_y[i] += bvy_applied;
         
         // Check if bullet is still on screen
-        if (sbullets[i].x >= 0 && sbullets[i].x < SCREEN_WIDTH &&
-            sbullets[i].y >= 0 && sbullets[i].y < SCREEN_HEIGHT) {
+        if (sbullet_x[i] >= 0 && sbullet_x[i] < SCREEN_WIDTH &&
+            sbullet_y[i] >= 0 && sbullet_y[i] < SCREEN_HEIGHT) {
             // Update sprite position
             unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, sbullets[i].x);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, sbullets[i].y);
+            sprite_move(ptr, &sbullet_shadow[i], sbullet_x[i], sbullet_y[i]);
+            collide_add(CT_SBULLET, i, sbullet_x[i], sbullet_y[i]);
         } else {
             // Off screen - deactivate
-            sbullets[i].status = -1;
+            sbullet_status[i] = -1;
             unsigned ptr = SBULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
+            sprite_hide(ptr, &sbullet_shadow[i]);
         }
     }
 }
+
+bool sbullet_live(uint8_t i)
+{
+    return sbullet_status[i] >= 0;
+}
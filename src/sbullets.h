@@ -20,13 +20,6 @@
  * Fires when button C is pressed   
  */
 
-// Super bullet structure (same as regular bullets)
-typedef struct {
-    int16_t x, y;           // Position
-    int16_t status;         // -1 = inactive, 0-23 = active with direction
-    int16_t vx_rem, vy_rem; // Velocity remainder for sub-pixel movement
-} SBullet;
-
 /**
  * Move all super bullets offscreen (for game over)
  */
@@ -46,11 +39,17 @@ bool fire_sbullet(uint8_t player_rotation);
 /**
  * Update all active super bullets
  * - Move bullets based on direction
- * - Check collisions with enemies
+ * - Register them for run_collisions()
  * - Remove off-screen bullets
  */
 void update_sbullets(void);
 
+/**
+ * Collision response (see collision.c): super bullets pass through what
+ * they hit, so they are only ever queried
+ */
+bool sbullet_live(uint8_t i);
+
 // Exposed cooldown value so other modules may read/set it
 extern int16_t sbullet_cooldown;
 
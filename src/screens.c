@@ -15,6 +15,7 @@ extern void draw_text(int16_t x, int16_t y, const char* text, uint8_t color);
 extern void clear_rect(int16_t x, int16_t y, int16_t width, int16_t height);
 extern void move_fighters_offscreen(void);
 extern void move_ebullets_offscreen(void);
+extern void move_bullets_offscreen(void);
 extern void reset_player_position(void);
 extern int8_t check_high_score(int16_t score);
 extern void get_player_initials(char* initials);
@@ -26,27 +27,15 @@ extern void stop_music(void);
 extern void move_asteroids_offscreen(void);
 
 extern int16_t game_level;
-extern int16_t game_score;
+extern bcd_t game_score;
 extern const uint16_t vlen;
 
-// Bullet structure
-typedef struct {
-    int16_t x, y;
-    int16_t vx, vy;
-    int16_t status;
-} Bullet;
-
-extern Bullet bullets[];
-
 // extern gamepad_t gamepad[GAMEPAD_COUNT];
 extern uint8_t keystates[KEYBOARD_BYTES];
 
 // Key macro
 #define key(code) (keystates[code >> 3] & (1 << (code & 7)))
 
-// Sprite configuration addresses
-// extern unsigned BULLET_CONFIG;
-
 /**
  * Display level up message and wait for START button
  */
@@ -139,20 +128,12 @@ void show_game_over(void)
     move_asteroids_offscreen();
     
     // Move all bullets offscreen
-    for (uint8_t i = 0; i < MAX_BULLETS; i++) {
-        if (bullets[i].status >= 0) {
-            unsigned ptr = BULLET_CONFIG + i * sizeof(vga_mode4_sprite_t);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, x_pos_px, -100);
-            xram0_struct_set(ptr, vga_mode4_sprite_t, y_pos_px, -100);
-            bullets[i].status = -1;
-        }
-    }
+    move_bullets_offscreen();
 
     // reset power-up state
     powerup.active = false;
     // Move power-up sprite offscreen
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, x_pos_px, -100);
-    xram0_struct_set(POWERUP_CONFIG, vga_mode4_sprite_t, y_pos_px, -100);
+    move_powerup_offscreen();
 
     // Reset player position to center
     reset_player_position();
@@ -177,7 +158,7 @@ void show_game_over(void)
     
     printf("\n*** GAME OVER ***\n");
     printf("Final Level: %d\n", game_level);
-    printf("Final Score: %d\n", game_score);
+    printf("Final Score: %lX\n", (unsigned long)game_score);  // BCD prints as hex
     
     uint8_t vsync_last = RIA.vsync;
     bool fire_initially_released = false;
@@ -1,5 +1,7 @@
 #include "sound.h"
 #include "constants.h"
+#include "xram_stats.h"
+#include "xram_queue.h"
 #include <rp6502.h>
 #include <stdint.h>
 
@@ -22,8 +24,7 @@ static void stop_sound(uint8_t channel)
     if (channel > 7) return;
     
     uint16_t psg_addr = PSG_XRAM_ADDR + (channel * 8) + 6;  // pan_gate offset
-    RIA.addr0 = psg_addr;
-    RIA.rw0 = 0x00;  // Gate off (release)
+    xram_put(psg_addr, 0x00);  // Gate off (release)
 }
 
 // ============================================================================
@@ -47,6 +48,7 @@ void play_sound(uint8_t sfx_type, uint16_t freq, uint8_t wave,
                 uint8_t attack, uint8_t decay, uint8_t release, uint8_t volume)
 {
     if (sfx_type >= SFX_TYPE_COUNT) return;
+    XRAM_OWNER_SAVE(XS_SOUND);
     
     // Get base channel for this effect type (each type has 2 channels)
     uint8_t base_channel = sfx_type * 2;
@@ -63,22 +65,21 @@ void play_sound(uint8_t sfx_type, uint16_t freq, uint8_t wave,
     
     // Set frequency (Hz * 3)
     uint16_t freq_val = freq * 3;
-    RIA.addr0 = psg_addr;
-    RIA.rw0 = freq_val & 0xFF;          // freq low byte
-    RIA.rw0 = (freq_val >> 8) & 0xFF;   // freq high byte
+    xram_put16(psg_addr, freq_val);     // freq low, high byte
     
     // Set duty cycle (50%)
-    RIA.rw0 = 128;
+    xram_put(psg_addr + 2, 128);
     
     // Set volume and attack
-    RIA.rw0 = (volume << 4) | (attack & 0x0F);
+    xram_put(psg_addr + 3, (volume << 4) | (attack & 0x0F));
     
     // Set decay volume to 15 (silent) so sound fades naturally without sustain
-    RIA.rw0 = (15 << 4) | (decay & 0x0F);
+    xram_put(psg_addr + 4, (15 << 4) | (decay & 0x0F));
     
     // Set waveform and release
-    RIA.rw0 = (wave << 4) | (release & 0x0F);
+    xram_put(psg_addr + 5, (wave << 4) | (release & 0x0F));
     
     // Set pan (center) and gate (on)
-    RIA.rw0 = 0x01;  // Center pan, gate on
+    xram_put(psg_addr + 6, 0x01);  // Center pan, gate on
+    XRAM_OWNER_RESTORE();
 }
@@ -1,13 +1,10 @@
+#include "constants.h"
 #include <rp6502.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <fcntl.h>
 #include <unistd.h>
 
-// Assuming this is defined globally in your project.
-// If not, you may need to extern it or pass it in.
-// extern unsigned BITMAP_CONFIG;
-
 extern void draw_text(uint16_t x, uint16_t y, const char *str, uint8_t colour);
 
 void load_palette_to_xram(const char *filename, unsigned address) {
@@ -65,9 +62,9 @@ void show_splash_screen(void) {
     const uint8_t red_color = 0x03;
     const uint16_t center_x = 110;
 
-    // 1. Load the Palette to Free Space (0xF000)
+    // 1. Load the Palette to its XRAM region (PALETTE_DATA)
     // The palette file is 512 bytes (256 colors * 2 bytes)
-    load_palette_to_xram("title_screen_pal.bin", 0xF000);
+    load_palette_to_xram("title_screen_pal.bin", PALETTE_DATA);
 
     // 2. Load the Bitmap Indices to Background (0x0000)
     load_file_to_xram("title_screen.bin", 0x0000);
@@ -0,0 +1,78 @@
+#include "sprite_shadow.h"
+#include "xram_queue.h"
+#include <rp6502.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// No sprite is ever placed here, so a reset shadow never matches
+#define UNKNOWN_POS     INT16_MIN
+#define UNKNOWN_PTR     0xFFFF
+#define UNKNOWN_SIZE    0xFF
+#define UNKNOWN_ROT     0xFF
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+void sprite_shadow_reset(sprite_shadow_t *shadow, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i++) {
+        shadow[i].x = UNKNOWN_POS;
+        shadow[i].y = UNKNOWN_POS;
+        shadow[i].xram_sprite_ptr = UNKNOWN_PTR;
+        shadow[i].log_size = UNKNOWN_SIZE;
+        shadow[i].rotation = UNKNOWN_ROT;
+    }
+}
+
+/**
+ * Write one 16-bit config field at XRAM address addr, skipping either byte
+ * if it already holds the new value
+ */
+static void shadow_put(unsigned addr, int16_t *field, int16_t value)
+{
+    uint16_t diff = (uint16_t)(*field ^ value);
+    if (diff == 0) return;
+    *field = value;
+
+    if (diff & 0x00FF) xram_put(addr, value & 0xFF);
+    if (diff & 0xFF00) xram_put(addr + 1, (value >> 8) & 0xFF);
+}
+
+void sprite_move(unsigned cfg, sprite_shadow_t *shadow, int16_t x, int16_t y)
+{
+    shadow_put(cfg + offsetof(vga_mode4_sprite_t, x_pos_px), &shadow->x, x);
+    shadow_put(cfg + offsetof(vga_mode4_sprite_t, y_pos_px), &shadow->y, y);
+}
+
+void asprite_move(unsigned cfg, sprite_shadow_t *shadow, int16_t x, int16_t y)
+{
+    shadow_put(cfg + offsetof(vga_mode4_asprite_t, x_pos_px), &shadow->x, x);
+    shadow_put(cfg + offsetof(vga_mode4_asprite_t, y_pos_px), &shadow->y, y);
+}
+
+void asprite_rotate(unsigned cfg, sprite_shadow_t *shadow,
+                    const int16_t table[][6], uint8_t r)
+{
+    if (shadow->rotation == r) return;
+    shadow->rotation = r;
+
+    const int16_t *m = table[r];
+    for (uint8_t k = 0; k < 6; k++) {
+        xram_put16(cfg + offsetof(vga_mode4_asprite_t, transform) + k * 2, m[k]);
+    }
+}
+
+void sprite_image(unsigned cfg, sprite_shadow_t *shadow, uint16_t data, uint8_t log_size)
+{
+    if (shadow->xram_sprite_ptr != data) {
+        shadow->xram_sprite_ptr = data;
+        xram_put16(cfg + offsetof(vga_mode4_sprite_t, xram_sprite_ptr), data);
+    }
+    if (shadow->log_size != log_size) {
+        shadow->log_size = log_size;
+        xram_put(cfg + offsetof(vga_mode4_sprite_t, log_size), log_size);
+        xram_put(cfg + offsetof(vga_mode4_sprite_t, has_opacity_metadata), false);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef SPRITE_SHADOW_H
+#define SPRITE_SHADOW_H
+
+#include <stdint.h>
+
+/**
+ * sprite_shadow.h - Changed-only uploads of mode 4 sprite configs
+ *
+ * Each sprite pool keeps one sprite_shadow_t per slot, holding the values
+ * last written to that slot's config in XRAM. The helpers below compare
+ * against the shadow and only write the bytes that differ, so a sprite
+ * that is parked off screen or standing still costs nothing. Writes go
+ * through xram_put() and are queued during gameplay.
+ *
+ * All writes to a pool's position and image fields must go through these
+ * helpers. Reset the shadow whenever the config is written some other way:
+ * load_config_image() restores every config from the prebuilt image at
+ * startup and in init_game(), so each pool's init resets its shadows and
+ * the first write after that goes through.
+ */
+
+// Parked sprites sit at (SPRITE_OFFSCREEN, SPRITE_OFFSCREEN)
+#define SPRITE_OFFSCREEN -100
+
+typedef struct {
+    int16_t x, y;               // x_pos_px, y_pos_px
+    uint16_t xram_sprite_ptr;
+    uint8_t log_size;           // has_opacity_metadata is always false
+    uint8_t rotation;           // affine sprites: row of the transform table
+} sprite_shadow_t;
+
+// Forget what XRAM holds so the next write of every field goes through
+void sprite_shadow_reset(sprite_shadow_t *shadow, uint8_t count);
+
+// Set the position of a vga_mode4_sprite_t at XRAM address cfg
+void sprite_move(unsigned cfg, sprite_shadow_t *shadow, int16_t x, int16_t y);
+
+// Set the position of a vga_mode4_asprite_t (affine) at XRAM address cfg
+void asprite_move(unsigned cfg, sprite_shadow_t *shadow, int16_t x, int16_t y);
+
+// Park a vga_mode4_sprite_t off screen
+#define sprite_hide(cfg, shadow) \
+    sprite_move((cfg), (shadow), SPRITE_OFFSCREEN, SPRITE_OFFSCREEN)
+
+// Park a vga_mode4_asprite_t off screen
+#define asprite_hide(cfg, shadow) \
+    asprite_move((cfg), (shadow), SPRITE_OFFSCREEN, SPRITE_OFFSCREEN)
+
+// Set the transform of a vga_mode4_asprite_t to row r of a prebuilt matrix
+// table (trig_tables.h). All 12 bytes go out as one run, and only when r
+// differs from the last rotation written.
+void asprite_rotate(unsigned cfg, sprite_shadow_t *shadow,
+                    const int16_t table[][6], uint8_t r);
+
+// Set the image of a vga_mode4_sprite_t (opacity metadata is cleared with
+// log_size)
+void sprite_image(unsigned cfg, sprite_shadow_t *shadow, uint16_t data, uint8_t log_size);
+
+#endif // SPRITE_SHADOW_H
@@ -0,0 +1,97 @@
+#include "stress.h"
+#include "constants.h"
+#include "random.h"
+#include "fighters.h"
+#include "asteroids.h"
+#include "explosions.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef STRESS_TEST
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+uint16_t stress_idle_polls = 0;
+
+// Frames run so far, including the uncounted first one
+static uint16_t stress_frames = 0;
+
+// delta_count[d - 1] is the number of frames that took d vsyncs
+static uint16_t delta_count[STRESS_MAX_DELTA];
+static uint8_t worst_delta = 0;
+
+static uint16_t polls_min = 0xFFFF;
+static uint16_t polls_max = 0;
+static uint32_t polls_total = 0;
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+void stress_start(void)
+{
+    for (uint8_t i = 0; i < STRESS_MAX_DELTA; i++) {
+        delta_count[i] = 0;
+    }
+    stress_frames = 0;
+    worst_delta = 0;
+    polls_min = 0xFFFF;
+    polls_max = 0;
+    polls_total = 0;
+    stress_idle_polls = 0;
+    printf("Stress: holding full load for %d frames\n", STRESS_FRAMES);
+}
+
+static void stress_report(void)
+{
+    uint16_t dropped = 0;
+
+    printf("\nStress: %u frames at full load\n", STRESS_FRAMES);
+    printf("  vsyncs  frames\n");
+    for (uint8_t d = 1; d <= STRESS_MAX_DELTA; d++) {
+        if (delta_count[d - 1] == 0) continue;
+        printf("  %u%s      %u\n", d, d == STRESS_MAX_DELTA ? "+" : " ", delta_count[d - 1]);
+        dropped += delta_count[d - 1] * (d - 1);
+    }
+    printf("  dropped %u frames, worst %u vsyncs\n", dropped, worst_delta);
+    printf("  idle polls/frame min %u avg %lu max %u\n", polls_min,
+           (unsigned long)(polls_total / STRESS_FRAMES), polls_max);
+}
+
+static void stress_fill_explosions(void)
+{
+    while (explosion_count() < MAX_EXPLOSIONS) {
+        // Spawns a cluster of up to 4 in the free slots
+        start_explosion(random(16, SCREEN_WIDTH - 16), random(16, SCREEN_HEIGHT - 16));
+    }
+}
+
+void stress_frame(uint8_t vsync_delta)
+{
+    // The first frame's wait spans the title screen and init_game()
+    if (stress_frames > 0 && vsync_delta > 0) {
+        if (vsync_delta > worst_delta) worst_delta = vsync_delta;
+        if (vsync_delta > STRESS_MAX_DELTA) vsync_delta = STRESS_MAX_DELTA;
+        delta_count[vsync_delta - 1]++;
+
+        if (stress_idle_polls < polls_min) polls_min = stress_idle_polls;
+        if (stress_idle_polls > polls_max) polls_max = stress_idle_polls;
+        polls_total += stress_idle_polls;
+    }
+    stress_idle_polls = 0;
+
+    if (stress_frames++ == STRESS_FRAMES) {
+        stress_report();
+        exit(0);
+    }
+
+    stress_fill_fighters();
+    stress_fill_asteroids();
+    stress_fill_explosions();
+}
+
+#endif // STRESS_TEST
@@ -0,0 +1,44 @@
+#ifndef STRESS_H
+#define STRESS_H
+
+#include <stdint.h>
+
+/**
+ * stress.h - Worst-case load mode for the gameplay loop (debug builds only)
+ *
+ * Compiled in with the ENABLE_STRESS_TEST CMake option (defines STRESS_TEST).
+ * The title screen drops straight into the attract-mode demo, which already
+ * steers the player and fires bullets and super bullets every frame. Each
+ * frame the stress hooks then refill every entity pool before the update
+ * pass runs:
+ *
+ *   - all MAX_FIGHTERS fighters alive and on screen
+ *   - all MAX_EBULLETS enemy bullets in flight
+ *   - all Large, Medium and Small asteroid slots active
+ *   - all MAX_EXPLOSIONS particles running
+ *
+ * After STRESS_FRAMES frames the distribution of frame times is printed and
+ * the program exits, so one run is one benchmark.
+ */
+
+#ifdef STRESS_TEST
+
+// Frames held at full load (must stay below DEMO_DURATION_FRAMES)
+#define STRESS_FRAMES (60 * 30)
+
+// Largest vsync delta with its own histogram bucket; anything above is lumped in
+#define STRESS_MAX_DELTA 8
+
+// Vsync polls spent waiting since the last frame, counted by the main loop
+extern uint16_t stress_idle_polls;
+
+// Clear the statistics (call after init_game)
+void stress_start(void);
+
+// Record one frame that took vsync_delta vsyncs, then refill every pool.
+// Prints the report and exits once STRESS_FRAMES frames have been measured.
+void stress_frame(uint8_t vsync_delta);
+
+#endif // STRESS_TEST
+
+#endif // STRESS_H
@@ -9,12 +9,15 @@
 #include <stdint.h>
 
 #include "random.h"
+#include "idle.h"
 #include "input.h"
+#include "replay.h"
 
 // External references
 extern void draw_text(uint16_t x, uint16_t y, const char *str, uint8_t colour);
 extern void clear_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
 extern void draw_high_scores(void);
+extern void repaint_high_scores(void);
 extern const uint16_t vlen;
 extern bool demo_mode_active;
 
@@ -48,8 +51,8 @@ void show_title_screen(void)
     uint8_t current_color = red_color;
     
     // SAVE ORIGINAL COLOR (Index 11)
-    // Palette starts at 0xF000. Index 11 is at 0xF000 + (11 * 2) = 0xF016
-    RIA.addr0 = 0xF016;
+    // Palette starts at PALETTE_DATA, 2 bytes per entry
+    RIA.addr0 = PALETTE_DATA + 11 * 2;
     RIA.step0 = 1;
     uint8_t orig_color_low = RIA.rw0;
     uint8_t orig_color_high = RIA.rw0;
@@ -62,10 +65,13 @@ void show_title_screen(void)
     bool start_button_was_pressed = false;  // Track button state for edge detection
     uint16_t highscore_counter = 0;
     while (true) {
-        // Wait for vertical sync
-        if (RIA.vsync == vsync_last)
+        // Wait for vertical sync, painting high score rows meanwhile
+        uint8_t vsync_now = RIA.vsync;
+        if (vsync_now == vsync_last) {
+            idle_run(vsync_last);
             continue;
-        vsync_last = RIA.vsync;
+        }
+        vsync_last = vsync_now;
 
         // Increment seed counter for randomness
         seed_counter++;
@@ -82,7 +88,7 @@ void show_title_screen(void)
             uint8_t source_index = 32 + ((color_cycle_timer / 4) % 224);
             
             // Calculate address of the source color
-            unsigned source_addr = 0xF000 + (source_index * 2);
+            unsigned source_addr = PALETTE_DATA + (source_index * 2);
             
             // Read the rainbow color
             RIA.addr0 = source_addr;
@@ -91,7 +97,7 @@ void show_title_screen(void)
             uint8_t r_high = RIA.rw0;
             
             // Write it to Index 11
-            RIA.addr0 = 0xF016;
+            RIA.addr0 = PALETTE_DATA + 11 * 2;
             RIA.rw0 = r_low;
             RIA.rw0 = r_high;
         }
@@ -100,7 +106,7 @@ void show_title_screen(void)
         highscore_counter++;
         if (highscore_counter >= 15) {
             highscore_counter = 0;
-            draw_high_scores();
+            repaint_high_scores();
         }
         
         // Update music
@@ -113,6 +119,11 @@ void show_title_screen(void)
         if (is_action_pressed(0, ACTION_PAUSE)) {
             start_pressed = true;
         }
+
+#ifdef INPUT_PLAYBACK
+        // Playback builds start the recorded game without waiting for START
+        start_pressed = true;
+#endif
         
         // Handle start with edge detection
         if (start_pressed) {
@@ -121,7 +132,8 @@ void show_title_screen(void)
                 start_button_was_pressed = true;
                 // Stop music
                 stop_music();
-                // Clear entire screen before exiting
+                // Drop any unfinished repaint, then clear entire screen before exiting
+                idle_clear();
                 RIA.addr0 = 0;
                 RIA.step0 = 1;
                 for (unsigned i = vlen; i--;) {
@@ -143,13 +155,12 @@ void show_title_screen(void)
                     }
                 }
 
-                // Initialize LFSR seed based on time spent on title screen
-                lfsr = seed_counter;
-                if (lfsr == 0) lfsr = 0xACE1; // Seed must never be 0
-                printf("LFSR initialized with seed: 0x%04X\n", lfsr);
+                // Seed the generator based on time spent on title screen
+                seed_random(seed_counter);
+                printf("Random seed: 0x%04X\n", random_state());
 
                 // --- RESTORE COLOR BEFORE EXIT ---
-                RIA.addr0 = 0xF016;
+                RIA.addr0 = PALETTE_DATA + 11 * 2;
                 RIA.step0 = 1;
                 RIA.rw0 = orig_color_low;
                 RIA.rw0 = orig_color_high;
@@ -162,12 +173,18 @@ void show_title_screen(void)
             start_button_was_pressed = false;
         }
 
+#ifdef STRESS_TEST
+        // Stress builds go straight into the demo, which the stress hooks
+        // then hold at full entity load
+        idle_frames = DEMO_IDLE_FRAMES;
+#endif
+
         // Demo countdown: always increment and start demo after timeout
         idle_frames++;
         if (idle_frames >= DEMO_IDLE_FRAMES) {
 
             // --- RESTORE COLOR BEFORE EXIT ---
-            RIA.addr0 = 0xF016;
+            RIA.addr0 = PALETTE_DATA + 11 * 2;
             RIA.step0 = 1;
             RIA.rw0 = orig_color_low;
             RIA.rw0 = orig_color_high;
@@ -175,7 +192,8 @@ void show_title_screen(void)
 
             demo_mode_active = true; // Set demo mode flag
 
-            // Clear entire screen before exiting
+            // Drop any unfinished repaint, then clear entire screen before exiting
+            idle_clear();
             RIA.addr0 = 0;
             RIA.step0 = 1;
             for (unsigned i = vlen; i--;) {
@@ -0,0 +1,34 @@
+#ifndef TRIG_TABLES_H
+#define TRIG_TABLES_H
+
+#include <stdint.h>
+#include "constants.h"
+
+/**
+ * trig_tables.h - Rotation tables for SHIP_ROTATION_STEPS steps
+ *
+ * Generated at build time by tools/gen_trig_tables.py from the step count
+ * in constants.h, so changing the angular resolution is a one-line edit.
+ * The count must be a power of two: step arithmetic then wraps with
+ * SHIP_ROTATION_MASK instead of a modulo or a compare.
+ *
+ * sin_fix/cos_fix hold 255 * sin/cos of each step. The affine tables hold
+ * a complete vga_mode4_asprite_t transform[6] (SX, SHY, TX, SHX, SY, TY)
+ * per step, so a rotation change is one 12-byte streamed write
+ * (asprite_rotate() in sprite_shadow.h).
+ */
+
+#if SHIP_ROTATION_STEPS & SHIP_ROTATION_MASK
+#error "SHIP_ROTATION_STEPS must be a power of two"
+#endif
+
+extern const int16_t sin_fix[SHIP_ROTATION_STEPS];
+extern const int16_t cos_fix[SHIP_ROTATION_STEPS];
+
+// Player ship (translation that was t2_fix4)
+extern const int16_t affine_ship[SHIP_ROTATION_STEPS][6];
+
+// Large asteroid (translation that was t2_fix32)
+extern const int16_t affine_ast_l[SHIP_ROTATION_STEPS][6];
+
+#endif // TRIG_TABLES_H
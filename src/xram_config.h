@@ -0,0 +1,22 @@
+#ifndef XRAM_CONFIG_H
+#define XRAM_CONFIG_H
+
+#include <stdint.h>
+
+/**
+ * xram_config.h - Prebuilt image of the sprite and text plane configs
+ *
+ * tools/gen_xram_config.py builds the whole config block, from
+ * VGA_CONFIG_START through the text plane config, at build time. Every
+ * sprite starts parked off screen with its image and size set, and the
+ * Earth starts centred. Boot and every new game upload it as one streamed
+ * copy instead of rebuilding each config field by field.
+ *
+ * The block order and every *_CONFIG address come from src/xram_map.txt,
+ * the same table that generates xram_map.h, so the two cannot drift apart.
+ */
+
+extern const uint16_t xram_config_size;
+extern const uint8_t xram_config_image[];
+
+#endif // XRAM_CONFIG_H
@@ -0,0 +1,141 @@
+#include "xram_queue.h"
+#include "xram_stats.h"
+#include <rp6502.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// MODULE STATE
+// ============================================================================
+
+static bool deferring = false;
+
+// Where port 1 points: the next byte written to it lands here
+static unsigned stream_next = 0;
+
+// Queued bytes, stored run after run
+static uint8_t queue_data[XRAM_QUEUE_BYTES];
+static uint16_t queue_len = 0;
+
+// Runs of consecutive XRAM addresses
+static uint16_t run_addr[XRAM_QUEUE_RUNS];
+static uint8_t run_len[XRAM_QUEUE_RUNS];
+static uint8_t run_count = 0;
+
+#ifdef XRAM_STATS
+// Owner of each run, so flushed traffic is charged to whoever queued it
+static uint8_t run_owner[XRAM_QUEUE_RUNS];
+#endif
+
+// ============================================================================
+// FUNCTIONS
+// ============================================================================
+
+void xram_queue_init(void)
+{
+    RIA.step1 = 1;
+    RIA.addr1 = 0;
+    stream_next = 0;
+    queue_len = 0;
+    run_count = 0;
+    deferring = false;
+}
+
+/**
+ * Point port 1 at addr, unless it is already parked there
+ */
+static inline void stream_seek(unsigned addr)
+{
+    if (addr != stream_next) {
+        RIA.addr1 = addr;
+    }
+}
+
+void xram_queue_begin(void)
+{
+    queue_len = 0;
+    run_count = 0;
+    deferring = true;
+}
+
+void xram_queue_end(void)
+{
+    xram_queue_flush();
+    deferring = false;
+}
+
+void xram_queue_flush(void)
+{
+    const uint8_t *p = queue_data;
+#ifdef XRAM_STATS
+    uint8_t owner = xram_owner;
+#endif
+
+    for (uint8_t r = 0; r < run_count; r++) {
+    #ifdef XRAM_STATS
+        xram_owner = run_owner[r];
+    #endif
+        stream_seek(run_addr[r]);
+        for (uint8_t n = run_len[r]; n > 0; n--) {
+            RIA.rw1 = *p++;
+        }
+        stream_next = run_addr[r] + run_len[r];
+    }
+#ifdef XRAM_STATS
+    xram_owner = owner;
+#endif
+
+    queue_len = 0;
+    run_count = 0;
+}
+
+void xram_put(unsigned addr, uint8_t value)
+{
+    if (!deferring) {
+        stream_seek(addr);
+        RIA.rw1 = value;
+        stream_next = addr + 1;
+        return;
+    }
+
+    if (queue_len == XRAM_QUEUE_BYTES) {
+        xram_queue_flush();
+    }
+
+    uint8_t last = run_count - 1;
+    if (run_count > 0 && run_len[last] < 255 &&
+        addr == run_addr[last] + run_len[last]
+    #ifdef XRAM_STATS
+        && run_owner[last] == xram_owner
+    #endif
+        ) {
+        // Continues the current run
+        run_len[last]++;
+    } else {
+        if (run_count == XRAM_QUEUE_RUNS) {
+            xram_queue_flush();
+        }
+        run_addr[run_count] = addr;
+        run_len[run_count] = 1;
+    #ifdef XRAM_STATS
+        run_owner[run_count] = xram_owner;
+    #endif
+        run_count++;
+    }
+    queue_data[queue_len++] = value;
+}
+
+void xram_put16(unsigned addr, uint16_t value)
+{
+    xram_put(addr, value & 0xFF);
+    xram_put(addr + 1, (value >> 8) & 0xFF);
+}
+
+void xram_put_block(unsigned addr, const uint8_t *data, uint16_t len)
+{
+    stream_seek(addr);
+    for (uint16_t i = 0; i < len; i++) {
+        RIA.rw1 = data[i];
+    }
+    stream_next = addr + len;
+}
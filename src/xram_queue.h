@@ -0,0 +1,60 @@
+#ifndef XRAM_QUEUE_H
+#define XRAM_QUEUE_H
+
+#include <stdint.h>
+
+/**
+ * xram_queue.h - Deferred XRAM writes, flushed once per frame after vsync
+ *
+ * During gameplay, sprite configs (through sprite_shadow), the HUD's text
+ * plane cells and PSG registers are not written when the simulation
+ * decides on them. They are appended to a RAM buffer instead and streamed
+ * out by xram_queue_flush() at the start of the next frame, right after the
+ * vsync edge, so they land during blanking rather than mid scan-out.
+ *
+ * Writes to consecutive addresses are merged into one run as they are
+ * queued, and each run costs a single addr0 setup when flushed. Queued
+ * writes keep their order, so a later write to the same byte wins.
+ *
+ * Outside xram_queue_begin()/xram_queue_end() (title, splash, level-up and
+ * game-over screens) xram_put() writes through immediately.
+ *
+ * The two RIA ports are split by access pattern. Port 1 belongs to this
+ * module and stays parked where the last write left it (step1 is always 1),
+ * so a write that continues the previous one, queued or not, skips the
+ * addr1 setup entirely. Port 0 serves everything random access: pixel
+ * plots (set() in graphics.h) and input reads. Sprite configs always go
+ * through xram_put(). Nothing outside this module may touch addr1, step1
+ * or rw1.
+ */
+
+// Queued data bytes and runs; a full queue is flushed early
+#define XRAM_QUEUE_BYTES 512
+#define XRAM_QUEUE_RUNS  128
+
+// Park port 1 at a known address (call once, before any xram_put())
+void xram_queue_init(void);
+
+// Start deferring xram_put() writes (call when gameplay starts, and again
+// when a blocking screen returns)
+void xram_queue_begin(void);
+
+// Flush and go back to writing through (call when gameplay ends, and before
+// any blocking screen: its own writes would otherwise sit in the queue
+// until it fills)
+void xram_queue_end(void);
+
+// Stream all queued writes to XRAM (call right after the vsync edge)
+void xram_queue_flush(void);
+
+// Write one byte of XRAM, deferred while the queue is active
+void xram_put(unsigned addr, uint8_t value);
+
+// Write a little-endian 16-bit field
+void xram_put16(unsigned addr, uint16_t value);
+
+// Stream len bytes from RAM to XRAM at addr. Always writes through, so
+// only call it outside gameplay or right after xram_queue_flush().
+void xram_put_block(unsigned addr, const uint8_t *data, uint16_t len);
+
+#endif // XRAM_QUEUE_H
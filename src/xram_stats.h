@@ -0,0 +1,61 @@
+#ifndef XRAM_STATS_H
+#define XRAM_STATS_H
+
+#include <stdint.h>
+
+/**
+ * xram_stats.h - Attribute RIA port traffic to game subsystems
+ *
+ * Game code marks which subsystem is about to touch XRAM with XRAM_OWNER().
+ * With XRAM_STATS defined (ENABLE_XRAM_STATS in a host build) the emulated
+ * RIA charges every RIA.rw0/rw1 access, including those inside
+ * xram0_struct_set(), to the current owner as a read or a write, and
+ * rpmegafighter_host prints the per-frame totals on exit. Otherwise the markers compile to nothing.
+ *
+ * Helpers called from several subsystems (play_sound, start_explosion)
+ * save the owner, switch to their own and restore it on return.
+ */
+
+enum {
+    XS_OTHER = 0,   // title/level screens, Earth, power-up, overlays
+    XS_INPUT,
+    XS_SOUND,       // PSG sound effects and music
+    XS_PLAYER,
+    XS_FIGHTERS,
+    XS_EBULLETS,
+    XS_BULLETS,
+    XS_SBULLETS,
+    XS_ASTEROIDS,
+    XS_EXPLOSIONS,
+    XS_STARS,
+    XS_HUD,
+    XS_COLLISIONS,  // hits resolved by run_collisions()
+    XS_COUNT
+};
+
+#define XRAM_OWNER_NAMES {                                      \
+    "other", "input", "psg/music", "player", "fighters",        \
+    "ebullets", "bullets", "sbullets", "asteroids",             \
+    "explosions", "stars", "hud", "collisions"                  \
+}
+
+// Host report columns per owner: port reads, port writes, bytes changed
+enum { XSK_READ = 0, XSK_WRITE, XSK_CHANGED, XSK_COUNT };
+
+#ifdef XRAM_STATS
+
+extern uint8_t xram_owner;
+
+#define XRAM_OWNER(o)           (xram_owner = (o))
+#define XRAM_OWNER_SAVE(o)      uint8_t xram_owner_saved = xram_owner; xram_owner = (o)
+#define XRAM_OWNER_RESTORE()    (xram_owner = xram_owner_saved)
+
+#else
+
+#define XRAM_OWNER(o)           ((void)0)
+#define XRAM_OWNER_SAVE(o)      ((void)0)
+#define XRAM_OWNER_RESTORE()    ((void)0)
+
+#endif // XRAM_STATS
+
+#endif // XRAM_STATS_H
@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""
+Trig Table Generator
+Writes every rotation table declared in src/trig_tables.h and
+src/heading.h for SHIP_ROTATION_STEPS (read from src/constants.h, and
+required to be a power of two so step arithmetic wraps with a mask):
+- sin_fix/cos_fix, 255 * sin/cos of each step
+- affine_ship/affine_ast_l, one complete vga_mode4_asprite_t transform per
+  step
+- heading_octant, the ratio-to-step table behind heading_step()
+
+Usage: gen_trig_tables.py SRC_DIR OUTPUT.c
+"""
+
+import math
+import sys
+
+from gen_xram_map import MapError, read_defines, resolve
+
+# Table name -> translation scale. The translation keeps the sprite rotating
+# about its centre: scale * int(181 * sin(theta - pi/4) + 127), which is
+# what the hand-written t2_fix4 (x8) and t2_fix32 (x32) tables held.
+AFFINE_TABLES = [
+    ('affine_ship', 8),    # player ship
+    ('affine_ast_l', 32),  # large asteroid
+]
+
+
+def trig(r, steps):
+    """255 * sin/cos of rotation step r, truncated toward zero"""
+    theta = math.radians(r * 360 / steps)
+    return (int(round(255 * math.sin(theta), 9)),
+            int(round(255 * math.cos(theta), 9)))
+
+
+def offset(r, steps, scale):
+    theta = math.radians(r * 360 / steps)
+    return scale * int(round(181 * math.sin(theta - math.pi / 4) + 127, 9))
+
+
+def matrix(r, steps, scale):
+    s, c = trig(r, steps)
+    # TY uses the inverse angle, so step 0 and step steps share offset 0
+    return [c, -s, offset(r, steps, scale), s, c,
+            offset(steps - r, steps, scale)]
+
+
+def heading(i, steps, ratio_bits):
+    """Rotation step nearest the angle of ratios in [i, i+1) / 2^ratio_bits"""
+    ratio = (i + 0.5) / (1 << ratio_bits)
+    return int(math.degrees(math.atan(ratio)) * steps / 360 + 0.5)
+
+
+def rows(values, per_row):
+    return ['    ' + ', '.join(values[i:i + per_row]) + ','
+            for i in range(0, len(values), per_row)]
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__.strip().splitlines()[-1])
+        sys.exit(1)
+
+    d = read_defines(sys.argv[1])
+    steps = resolve('SHIP_ROTATION_STEPS', d)
+    if steps < 8 or steps & (steps - 1):
+        raise MapError(f'SHIP_ROTATION_STEPS = {steps} is not a power of two >= 8')
+    with open(f'{sys.argv[1]}/heading.h') as f:
+        ratio_bits = next(int(line.split()[2]) for line in f
+                          if line.startswith('#define HEADING_RATIO_BITS'))
+
+    lines = [
+        '// Generated by tools/gen_trig_tables.py - do not edit',
+        '#include "trig_tables.h"',
+        '#include "heading.h"',
+        '',
+    ]
+    for name, index in (('sin_fix', 0), ('cos_fix', 1)):
+        values = [f'{trig(r, steps)[index]:4d}' for r in range(steps)]
+        lines.append(f'const int16_t {name}[SHIP_ROTATION_STEPS] = {{')
+        lines += rows(values, 8)
+        lines.append('};')
+        lines.append('')
+
+    for name, scale in AFFINE_TABLES:
+        lines.append(f'const int16_t {name}[SHIP_ROTATION_STEPS][6] = {{')
+        for r in range(steps):
+            values = ', '.join(f'{v:6d}' for v in matrix(r, steps, scale))
+            lines.append(f'    {{{values} }},  // {r * 360 / steps:g} deg')
+        lines.append('};')
+        lines.append('')
+
+    values = [str(heading(i, steps, ratio_bits)) for i in range(1 << ratio_bits)]
+    lines.append('const uint8_t heading_octant[HEADING_RATIOS] = {')
+    lines += rows(values, 16)
+    lines.append('};')
+    lines.append('')
+
+    with open(sys.argv[2], 'w') as f:
+        f.write('\n'.join(lines))
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except MapError as e:
+        print(f'gen_trig_tables.py: {e}', file=sys.stderr)
+        sys.exit(1)
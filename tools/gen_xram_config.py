@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+XRAM Config Image Generator
+Builds the initial contents of the config block laid out by
+src/xram_map.txt (see gen_xram_map.py), from VGA_CONFIG_START up to the
+text message cells, and writes it as the C array declared in
+src/xram_config.h.
+
+Usage: gen_xram_config.py SRC_DIR OUTPUT.c
+"""
+
+import math
+import struct
+import sys
+
+from gen_xram_map import MapError, load_map, read_defines, resolve
+
+OFFSCREEN = -100
+
+IDENTITY = [0x100, 0, 0, 0, 0x100, 0]
+
+
+def ship_transform():
+    """Rotation 0 of affine_ship (see gen_trig_tables.py)"""
+    base = int(round(181 * math.sin(-math.pi / 4) + 127, 9))
+    return [255, 0, 8 * base, 0, 255, 8 * base]
+
+
+# Configs that do not start parked with an identity transform
+TRANSFORMS = {'SPACECRAFT_CONFIG': ship_transform()}
+ON_SCREEN = {'EARTH_CONFIG'}     # starts centred
+
+
+# struct layouts, little endian, matching rp6502.h
+def mode4_sprite(x, y, data, log_size):
+    return struct.pack('<hhHBB', x, y, data, log_size, 0)
+
+
+def mode4_asprite(transform, x, y, data, log_size):
+    return struct.pack('<6h', *transform) + mode4_sprite(x, y, data, log_size)
+
+
+def build_image(src_dir):
+    regions, configs = load_map(src_dir)
+    addr = {r['name']: r['addr'] for r in regions}
+    addr.update({c['name']: c['addr'] for c in configs})
+    d = read_defines(src_dir)
+
+    image = bytearray()
+    for c in configs:
+        kind = c['type']
+        if kind == 'text':
+            # Message cells are composed at runtime; the image ends here
+            break
+        if c['addr'] != addr['VGA_CONFIG_START'] + len(image):
+            raise MapError(f'{c["name"]} is not where the image expects it')
+
+        for _ in range(c['count']):
+            if kind == 'mode3':
+                # 320x180 bitmap
+                image += struct.pack('<BBhhhhHH', 0, 0, 0, 0, 320, 180,
+                                     addr['BITMAP_DATA'], addr['PALETTE_DATA'])
+            elif kind == 'mode1':
+                # Text plane over the top of the screen
+                image += struct.pack('<BBhhhhHHH', 0, 0, 7, 1,
+                                     resolve('MESSAGE_WIDTH', d),
+                                     resolve('MESSAGE_HEIGHT', d),
+                                     addr['TEXT_MESSAGE_DATA'], 0xFFFF, 0xFFFF)
+            else:
+                x, y = OFFSCREEN, OFFSCREEN
+                if c['name'] in ON_SCREEN:
+                    x = resolve('SCREEN_WIDTH', d) // 2
+                    y = resolve('SCREEN_HEIGHT', d) // 2
+                data = addr[c['data']]
+                if kind == 'asprite':
+                    image += mode4_asprite(TRANSFORMS.get(c['name'], IDENTITY),
+                                           x, y, data, c['log_size'])
+                else:
+                    image += mode4_sprite(x, y, data, c['log_size'])
+    return image
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__.strip().splitlines()[-1])
+        sys.exit(1)
+
+    try:
+        image = build_image(sys.argv[1])
+    except MapError as e:
+        print(f'XRAM config error: {e}', file=sys.stderr)
+        sys.exit(1)
+
+    lines = [
+        '// Generated by tools/gen_xram_config.py - do not edit',
+        '#include "xram_config.h"',
+        '',
+        f'const uint16_t xram_config_size = {len(image)};',
+        '',
+        f'const uint8_t xram_config_image[{len(image)}] = {{',
+    ]
+    for i in range(0, len(image), 16):
+        row = ', '.join(f'0x{b:02X}' for b in image[i:i + 16])
+        lines.append(f'    {row},')
+    lines.append('};')
+    lines.append('')
+
+    with open(sys.argv[2], 'w') as f:
+        f.write('\n'.join(lines))
+
+
+if __name__ == '__main__':
+    main()
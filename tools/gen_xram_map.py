@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+"""
+XRAM Memory Map Generator
+Reads src/xram_map.txt, packs every unpinned region into the free XRAM,
+and writes xram_map.h (address #defines for every region and config) and,
+when a target is given, xram_assets.cmake (rp6502_asset lines for the
+sprite art plus the XRAM_MAP_ROMS list). Exits non-zero on any overlap or
+on a region that does not fit.
+
+Usage: gen_xram_map.py SRC_DIR OUT_DIR [TARGET]
+"""
+
+import os
+import re
+import sys
+
+XRAM_SIZE = 0x10000
+ALIGN = 2
+
+# Headers whose #defines may be used as config counts
+HEADERS = ['constants.h', 'sbullets.h', 'definitions.h']
+
+# Bytes per config entry, matching the structs in rp6502.h
+CONFIG_BYTES = {
+    'mode3': 14,    # vga_mode3_config_t
+    'mode1': 16,    # vga_mode1_config_t
+    'asprite': 20,  # vga_mode4_asprite_t
+    'sprite': 8,    # vga_mode4_sprite_t
+    'text': 3,      # one text plane character cell
+}
+
+DEFINE = re.compile(r'^\s*#define\s+(\w+)\s+([^/\n]+)')
+
+
+class MapError(Exception):
+    pass
+
+
+def read_defines(src_dir):
+    """Raw #define bodies from the game headers"""
+    defines = {}
+    for name in HEADERS:
+        with open(os.path.join(src_dir, name)) as f:
+            for line in f:
+                m = DEFINE.match(line)
+                if m:
+                    defines[m.group(1)] = m.group(2).strip()
+    return defines
+
+
+def resolve(expr, defines, depth=0):
+    """Evaluate a count: a number, a #define, or arithmetic on them"""
+    if depth > 8:
+        raise MapError(f'cannot resolve {expr}')
+    text = re.sub(r'[A-Za-z_]\w*',
+                  lambda m: str(resolve(defines[m.group(0)], defines, depth + 1))
+                  if m.group(0) in defines else m.group(0), expr)
+    if not re.fullmatch(r'[0-9a-fA-FxX+\-*/() ]+', text):
+        raise MapError(f'cannot resolve {expr}')
+    return int(eval(text.replace('/', '//')))
+
+
+def load_map(src_dir):
+    """Parse and place the map. Returns (regions, configs), both sorted in
+    declaration order; each entry is a dict with name, addr and size."""
+    root = os.path.dirname(os.path.abspath(src_dir))
+    defines = read_defines(src_dir)
+    regions = []
+    configs = []
+
+    with open(os.path.join(src_dir, 'xram_map.txt')) as f:
+        for lineno, line in enumerate(f, 1):
+            fields = line.split('#', 1)[0].split()
+            if not fields:
+                continue
+            where = f'xram_map.txt:{lineno}'
+
+            if fields[0] == 'config':
+                name, kind = fields[1], fields[2]
+                if kind not in CONFIG_BYTES:
+                    raise MapError(f'{where}: unknown config type {kind}')
+                count = resolve(fields[3], defines) if len(fields) > 3 else 1
+                configs.append({
+                    'name': name, 'type': kind, 'count': count,
+                    'data': fields[4] if len(fields) > 4 else None,
+                    'log_size': int(fields[5]) if len(fields) > 5 else None,
+                    'size': count * CONFIG_BYTES[kind],
+                })
+                continue
+
+            name, size = fields[0], fields[1]
+            region = {'name': name, 'file': None, 'addr': None,
+                      'index': len(regions)}
+            if size == 'configs':
+                region['size'] = None   # filled in below
+            elif size.startswith('images/'):
+                path = os.path.join(root, size)
+                if not os.path.exists(path):
+                    raise MapError(f'{where}: {size} not found')
+                region['file'] = size
+                region['size'] = os.path.getsize(path)
+            else:
+                region['size'] = int(size, 0)
+            if len(fields) > 2:
+                if not fields[2].startswith('@'):
+                    raise MapError(f'{where}: expected @ADDR, got {fields[2]}')
+                region['addr'] = int(fields[2][1:], 0)
+            regions.append(region)
+
+    # The config block is one region, laid out in declaration order
+    block = [r for r in regions if r['size'] is None]
+    if len(block) != 1:
+        raise MapError('xram_map.txt needs exactly one "configs" region')
+    block[0]['size'] = sum(c['size'] for c in configs)
+
+    place(regions)
+
+    offset = block[0]['addr']
+    for c in configs:
+        c['addr'] = offset
+        offset += c['size']
+    return regions, configs
+
+
+def place(regions):
+    """Pin the fixed regions, then first-fit the rest, largest first"""
+    pinned = sorted((r for r in regions if r['addr'] is not None),
+                    key=lambda r: r['addr'])
+    check_overlaps(pinned)
+
+    free = []
+    cursor = 0
+    for r in pinned:
+        if r['addr'] > cursor:
+            free.append([cursor, r['addr']])
+        cursor = r['addr'] + r['size']
+    if cursor < XRAM_SIZE:
+        free.append([cursor, XRAM_SIZE])
+
+    floating = sorted((r for r in regions if r['addr'] is None),
+                      key=lambda r: (-r['size'], r['index']))
+    for r in floating:
+        for span in free:
+            start = (span[0] + ALIGN - 1) & ~(ALIGN - 1)
+            if start + r['size'] <= span[1]:
+                r['addr'] = start
+                span[0] = start + r['size']
+                break
+        else:
+            largest = max((s[1] - s[0] for s in free), default=0)
+            raise MapError(f'{r["name"]} ({r["size"]} bytes) does not fit; '
+                           f'largest free span is {largest} bytes')
+
+    check_overlaps(sorted(regions, key=lambda r: r['addr']))
+
+
+def check_overlaps(ordered):
+    for a, b in zip(ordered, ordered[1:]):
+        if a['addr'] + a['size'] > b['addr']:
+            raise MapError(f'{a["name"]} (0x{a["addr"]:04X}-0x'
+                           f'{a["addr"] + a["size"]:04X}) overlaps {b["name"]} '
+                           f'(0x{b["addr"]:04X})')
+    for r in ordered:
+        if r['addr'] + r['size'] > XRAM_SIZE:
+            raise MapError(f'{r["name"]} runs past the end of XRAM')
+
+
+def free_spans(regions):
+    spans = []
+    cursor = 0
+    for r in sorted(regions, key=lambda r: r['addr']):
+        if r['addr'] > cursor:
+            spans.append((cursor, r['addr']))
+        cursor = r['addr'] + r['size']
+    if cursor < XRAM_SIZE:
+        spans.append((cursor, XRAM_SIZE))
+    return spans
+
+
+def write_header(path, regions, configs):
+    lines = [
+        '// Generated by tools/gen_xram_map.py from src/xram_map.txt - do not edit',
+        '#ifndef XRAM_MAP_H',
+        '#define XRAM_MAP_H',
+        '',
+        '// XRAM layout',
+    ]
+    rows = [(r['addr'], r['size'], r['name']) for r in regions]
+    rows += [(s, e - s, '(free)') for s, e in free_spans(regions)]
+    for addr, size, name in sorted(rows):
+        lines.append(f'// 0x{addr:04X} - 0x{addr + size:04X} {size:6d}  {name}')
+    lines.append('')
+
+    for r in sorted(regions, key=lambda r: r['addr']):
+        lines.append(f'#define {r["name"]:<20} 0x{r["addr"]:04X}')
+    lines.append('')
+    lines.append('// Config block')
+    for c in configs:
+        lines.append(f'#define {c["name"]:<20} 0x{c["addr"]:04X}'
+                     f'  // {c["count"]} x {c["type"]}')
+    lines.append('')
+    lines.append('#endif // XRAM_MAP_H')
+    lines.append('')
+    with open(path, 'w') as f:
+        f.write('\n'.join(lines))
+
+
+def write_cmake(path, regions, target):
+    assets = [r for r in regions if r['file']]
+    lines = ['# Generated by tools/gen_xram_map.py from src/xram_map.txt - do not edit']
+    for r in assets:
+        # 0x10000 selects XRAM in the ROM loader
+        lines.append(f'rp6502_asset({target} 0x1{r["addr"]:04X} {r["file"]})')
+    lines.append('set(XRAM_MAP_ROMS')
+    for r in assets:
+        lines.append(f'    {os.path.basename(r["file"])}.rp6502')
+    lines.append(')')
+    lines.append('')
+    with open(path, 'w') as f:
+        f.write('\n'.join(lines))
+
+
+def main():
+    if len(sys.argv) not in (3, 4):
+        print(__doc__.strip().splitlines()[-1])
+        sys.exit(1)
+    src_dir, out_dir = sys.argv[1], sys.argv[2]
+
+    try:
+        regions, configs = load_map(src_dir)
+    except MapError as e:
+        print(f'XRAM map error: {e}', file=sys.stderr)
+        sys.exit(1)
+
+    os.makedirs(out_dir, exist_ok=True)
+    write_header(os.path.join(out_dir, 'xram_map.h'), regions, configs)
+    if len(sys.argv) == 4:
+        write_cmake(os.path.join(out_dir, 'xram_assets.cmake'), regions,
+                    sys.argv[3])
+
+    free = sum(e - s for s, e in free_spans(regions))
+    print(f'XRAM map: {len(regions)} regions, {len(configs)} configs, '
+          f'{free} bytes free')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,1136 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 Rumbledethumps
+#
+# SPDX-License-Identifier: BSD-3-Clause
+# SPDX-License-Identifier: Unlicense
+
+# Cycle-counting 65C02 profiler for RP6502 ROMs
+#
+# Loads an .rp6502 ROM into an emulated W65C02S with a stubbed RIA register
+# file (XRAM ports, VSYNC, UART and the xstack OS calls) and runs it headless.
+# Function symbols come from the llvm-mos .elf next to the ROM. Every JSR to
+# a profiled function is timed until its matching RTS, and the inclusive
+# cycle counts are reported per frame against the vsync budget.
+#
+# Cycle counts follow the WDC datasheet per instruction, including page
+# crossing, taken branch and decimal mode penalties. RIA operations complete
+# instantly and the VGA is not emulated, so only CPU time is measured.
+#
+# Build the ROM with -DENABLE_PROFILE=ON so LTO keeps the profiled functions
+# out of main(), then for example:
+#   python3 tools/profile6502.py build/rpmegafighter.rp6502 --frames 1200
+
+import argparse
+import binascii
+import bisect
+import os
+import random
+import re
+import struct
+import sys
+
+from gen_xram_map import load_map
+
+DEFAULT_FUNCTIONS = [
+    "update_fighters",
+    "update_bullets",
+    "update_ebullets",
+    "fire_ebullet",
+    "update_asteroids",
+    "run_collisions",
+    "draw_stars",
+    "render_game",
+    "draw_hud",
+]
+
+def map_address(name):
+    """XRAM address of a region in src/xram_map.txt"""
+    src = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src")
+    regions, _ = load_map(src)
+    return next(r["addr"] for r in regions if r["name"] == name)
+
+
+# Defaults match xram_map.txt and input.h
+KEYBOARD_INPUT = map_address("KEYBOARD_INPUT")
+KEY_ENTER = 0x28
+KEY_SPACE = 0x2C
+
+# RIA register file
+RIA_READY = 0xFFE0
+RIA_TX = 0xFFE1
+RIA_RX = 0xFFE2
+RIA_VSYNC = 0xFFE3
+RIA_RW0 = 0xFFE4
+RIA_STEP0 = 0xFFE5
+RIA_ADDR0 = 0xFFE6
+RIA_RW1 = 0xFFE8
+RIA_STEP1 = 0xFFE9
+RIA_ADDR1 = 0xFFEA
+RIA_XSTACK = 0xFFEC
+RIA_ERRNO = 0xFFED
+RIA_OP = 0xFFEF
+RIA_SPIN = 0xFFF1
+RIA_A = 0xFFF4
+RIA_X = 0xFFF6
+RIA_SREG = 0xFFF8
+
+# RIA OS operations
+RIA_OP_ZXSTACK = 0x00
+RIA_OP_XREG = 0x01
+RIA_OP_PHI2 = 0x02
+RIA_OP_CODEPAGE = 0x03
+RIA_OP_LRAND = 0x04
+RIA_OP_STDIN_OPT = 0x05
+RIA_OP_CLOCK = 0x0F
+RIA_OP_OPEN = 0x14
+RIA_OP_CLOSE = 0x15
+RIA_OP_READ_XSTACK = 0x16
+RIA_OP_READ_XRAM = 0x17
+RIA_OP_WRITE_XSTACK = 0x18
+RIA_OP_WRITE_XRAM = 0x19
+RIA_OP_EXIT = 0xFF
+
+XSTACK_SIZE = 0x200
+O_RDONLY = 0x01
+ENOENT = 2
+EACCES = 13
+EBADF = 9
+
+# Back-to-back VSYNC reads closer than this are a wait loop
+SPIN_WINDOW = 32
+
+
+class EmulationError(RuntimeError):
+    pass
+
+
+# ============================================================================
+# ROM AND SYMBOL LOADING
+# ============================================================================
+
+
+def load_rp6502_rom(file: str, ram: bytearray, xram: bytearray):
+    """Load an RP6502 ROM. Addresses $10000-$1FFFF are XRAM."""
+    with open(file, "rb") as f:
+        command = f.readline().decode("cp850")
+        if not re.match(r"^#![Rr][Pp]6502\r?\n$", command):
+            raise RuntimeError(f"Invalid RP6502 ROM file: {file}")
+        while True:
+            command = f.readline().decode("ascii").rstrip()
+            if len(command) == 0:
+                break
+            if re.search(r"^ *#( |$)", command):
+                continue
+            data_match = re.search(r"^ *([^ ]+) *([^ ]+) *([^ ]+) *$", command)
+            if not data_match:
+                raise RuntimeError(f"Corrupt RP6502 ROM file: {file}")
+            addr, length, crc = (
+                int(re.sub(r"^\$", "0x", g), 0) for g in data_match.groups()
+            )
+            data = f.read(length)
+            if len(data) != length or crc != binascii.crc32(data):
+                raise RuntimeError(f"Invalid CRC in block address: ${addr:04X}")
+            if addr >= 0x10000:
+                xram[addr - 0x10000 : addr - 0x10000 + length] = data
+            else:
+                ram[addr : addr + length] = data
+
+
+def load_elf_functions(file: str) -> dict:
+    """Return {name: address} for every function symbol in an ELF32 file."""
+    with open(file, "rb") as f:
+        data = f.read()
+    if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+        raise RuntimeError(f"Not a little-endian ELF32 file: {file}")
+    shoff = struct.unpack_from("<I", data, 0x20)[0]
+    shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+    sections = [
+        struct.unpack_from("<10I", data, shoff + i * shentsize) for i in range(shnum)
+    ]
+    functions = {}
+    for sh in sections:
+        if sh[1] != 2:  # SHT_SYMTAB
+            continue
+        strtab = sections[sh[6]]
+        for off in range(sh[4], sh[4] + sh[5], 16):
+            st_name, st_value, st_size, st_info = struct.unpack_from(
+                "<IIIB", data, off
+            )
+            if st_info & 0xF != 2:  # STT_FUNC
+                continue
+            start = strtab[4] + st_name
+            name = data[start : data.index(b"\0", start)].decode("ascii")
+            functions[name] = st_value & 0xFFFF
+    return functions
+
+
+# ============================================================================
+# MACHINE
+# ============================================================================
+
+
+class Machine:
+    """W65C02S with 64K RAM and a stubbed RIA at $FFE0-$FFF9."""
+
+    def __init__(self, phi2_khz: int, root: str, echo: bool):
+        self.ram = bytearray(0x10000)
+        self.xram = bytearray(0x10000)
+        self.root = root
+        self.echo = echo
+        self.phi2_khz = phi2_khz
+        self.cycles_per_frame = phi2_khz * 1000 // 60
+
+        self.a = self.x = self.y = 0
+        self.s = 0xFD
+        self.pc = 0
+        self.n = self.v = self.d = self.c = 0
+        self.i = 1
+        self.z = 1  # Z flag is set when this is 0
+        self.px = 0  # page-cross penalty of the last indexed address
+        self.cycles = 0
+        self.running = True
+        self.exit_code = None
+
+        # RIA state
+        self.step = [1, 1]
+        self.addr = [0, 0]
+        self.xstack = bytearray(XSTACK_SIZE + 1)
+        self.xsp = XSTACK_SIZE
+        self.files = {}
+        self.next_fd = 3
+        self.warned_ops = set()
+        self.vsync = 0
+        self.next_vsync = self.cycles_per_frame
+        self.last_vsync_read = -SPIN_WINDOW
+        self.idle = {}  # frame index -> idle cycles skipped
+        self.frame_hook = None
+
+        # Fast-path set of registers with side effects
+        self.io_read = {
+            RIA_RX: self.rd_rx,
+            RIA_VSYNC: self.rd_vsync,
+            RIA_RW0: lambda: self.rd_rw(0),
+            RIA_RW1: lambda: self.rd_rw(1),
+            RIA_XSTACK: self.rd_xstack,
+        }
+        self.io_write = {
+            RIA_TX: self.wr_tx,
+            RIA_RW0: lambda v: self.wr_rw(0, v),
+            RIA_STEP0: lambda v: self.wr_step(0, v),
+            RIA_ADDR0: lambda v: self.wr_addr(0, 0, v),
+            RIA_ADDR0 + 1: lambda v: self.wr_addr(0, 8, v),
+            RIA_RW1: lambda v: self.wr_rw(1, v),
+            RIA_STEP1: lambda v: self.wr_step(1, v),
+            RIA_ADDR1: lambda v: self.wr_addr(1, 0, v),
+            RIA_ADDR1 + 1: lambda v: self.wr_addr(1, 8, v),
+            RIA_XSTACK: self.wr_xstack,
+            RIA_OP: self.wr_op,
+        }
+
+        # Profiling
+        self.watch = {}  # address -> name
+        self.open_calls = []  # [name, start cycle, stack pointer]
+        self.on_call_done = None
+        self.flat = None  # per-PC cycle counts when enabled
+
+        self.table = build_opcode_table(self)
+
+    def reset(self):
+        ram = self.ram
+        ram[RIA_READY] = 0x80  # TX always ready, no RX
+        ram[RIA_STEP0] = ram[RIA_STEP1] = 1
+        ram[RIA_SPIN : RIA_SPIN + 7] = bytes([0x80, 0x00, 0xA9, 0, 0xA2, 0, 0x60])
+        self.pc = ram[0xFFFC] | ram[0xFFFD] << 8
+
+    # ---- bus ----------------------------------------------------------------
+
+    def rd(self, a):
+        if 0xFFE0 <= a < 0xFFF0:
+            fn = self.io_read.get(a)
+            if fn:
+                return fn()
+        return self.ram[a]
+
+    def wr(self, a, v):
+        if 0xFFE0 <= a < 0xFFFA:
+            fn = self.io_write.get(a)
+            if fn:
+                fn(v)
+                return
+        self.ram[a] = v
+
+    # ---- RIA registers ------------------------------------------------------
+
+    def rd_rx(self):
+        return 0
+
+    def rd_vsync(self):
+        now = self.cycles
+        if now - self.last_vsync_read < SPIN_WINDOW and now < self.next_vsync:
+            # The game is waiting for vsync; skip the idle loop
+            frame = now // self.cycles_per_frame
+            self.idle[frame] = self.idle.get(frame, 0) + self.next_vsync - now
+            self.cycles = now = self.next_vsync
+        self.last_vsync_read = now
+        while now >= self.next_vsync:
+            self.vsync = (self.vsync + 1) & 0xFF
+            self.next_vsync += self.cycles_per_frame
+            if self.frame_hook:
+                self.frame_hook()
+        return self.vsync
+
+    def rd_rw(self, port):
+        a = self.addr[port]
+        self.advance(port)
+        return self.xram[a]
+
+    def wr_rw(self, port, v):
+        self.xram[self.addr[port]] = v
+        self.advance(port)
+
+    def advance(self, port):
+        a = self.addr[port] = (self.addr[port] + self.step[port]) & 0xFFFF
+        reg = RIA_ADDR0 + port * 4
+        self.ram[reg] = a & 0xFF
+        self.ram[reg + 1] = a >> 8
+
+    def wr_step(self, port, v):
+        self.ram[RIA_STEP0 + port * 4] = v
+        self.step[port] = v - 0x100 if v & 0x80 else v
+
+    def wr_addr(self, port, shift, v):
+        a = self.addr[port] & (0xFF00 >> shift)
+        self.addr[port] = a | v << shift
+        self.ram[RIA_ADDR0 + port * 4 + (shift >> 3)] = v
+
+    def wr_tx(self, v):
+        if self.echo:
+            sys.stdout.write(chr(v))
+
+    def rd_xstack(self):
+        if self.xsp >= XSTACK_SIZE:
+            return 0
+        v = self.xstack[self.xsp]
+        self.xsp += 1
+        return v
+
+    def wr_xstack(self, v):
+        if self.xsp > 0:
+            self.xsp -= 1
+            self.xstack[self.xsp] = v
+
+    def pop_uint16(self):
+        return self.rd_xstack() | self.rd_xstack() << 8
+
+    # ---- RIA OS operations --------------------------------------------------
+
+    def wr_op(self, op):
+        ax = self.ram[RIA_A] | self.ram[RIA_X] << 8
+        result = 0
+        if op == RIA_OP_EXIT:
+            self.running = False
+            self.exit_code = self.ram[RIA_A]
+        elif op == RIA_OP_PHI2:
+            result = self.phi2_khz
+        elif op == RIA_OP_LRAND:
+            result = random.getrandbits(31)
+        elif op == RIA_OP_CLOCK:
+            result = self.cycles * 100 // (self.phi2_khz * 1000)
+        elif op == RIA_OP_OPEN:
+            result = self.os_open(ax)
+        elif op == RIA_OP_CLOSE:
+            f = self.files.pop(ax, None)
+            result = self.fail(EBADF) if f is None else f.close() or 0
+        elif op == RIA_OP_READ_XSTACK:
+            result = self.os_read_xstack(ax, self.pop_uint16())
+        elif op == RIA_OP_READ_XRAM:
+            count = self.pop_uint16()
+            result = self.os_read_xram(ax, self.pop_uint16(), count)
+        elif op == RIA_OP_WRITE_XSTACK:
+            data = bytes(self.xstack[self.xsp : XSTACK_SIZE])
+            if ax in (1, 2):
+                if self.echo:
+                    sys.stdout.write(data.decode("cp850"))
+                result = len(data)
+            else:
+                result = self.fail(EACCES)
+        elif op == RIA_OP_WRITE_XRAM:
+            result = self.fail(EACCES)
+        elif op not in (RIA_OP_ZXSTACK, RIA_OP_XREG, RIA_OP_CODEPAGE, RIA_OP_STDIN_OPT):
+            if op not in self.warned_ops:
+                self.warned_ops.add(op)
+                print(f"profile6502: unhandled RIA op ${op:02X}", file=sys.stderr)
+        self.xsp = XSTACK_SIZE
+        result &= 0xFFFFFFFF
+        ram = self.ram
+        ram[RIA_A] = result & 0xFF
+        ram[RIA_X] = result >> 8 & 0xFF
+        ram[RIA_SREG] = result >> 16 & 0xFF
+        ram[RIA_SREG + 1] = result >> 24 & 0xFF
+
+    def fail(self, errno):
+        self.ram[RIA_ERRNO] = errno
+        self.ram[RIA_ERRNO + 1] = 0
+        return -1
+
+    def os_open(self, flags):
+        # Files are read-only so a profiling run never touches saves
+        path = bytes(self.xstack[self.xsp : XSTACK_SIZE]).split(b"\0")[0]
+        if (flags & 0x03) != O_RDONLY:
+            return self.fail(EACCES)
+        try:
+            f = open(os.path.join(self.root, path.decode("cp850")), "rb")
+        except OSError:
+            return self.fail(ENOENT)
+        fd = self.next_fd
+        self.next_fd += 1
+        self.files[fd] = f
+        return fd
+
+    def os_read_xstack(self, fd, count):
+        f = self.files.get(fd)
+        if f is None:
+            return self.fail(EBADF)
+        data = f.read(min(count, XSTACK_SIZE))
+        self.xsp = XSTACK_SIZE - len(data)
+        self.xstack[self.xsp : XSTACK_SIZE] = data
+        return len(data)
+
+    def os_read_xram(self, fd, buf, count):
+        f = self.files.get(fd)
+        if f is None:
+            return self.fail(EBADF)
+        data = f.read(min(count, 0x10000 - buf))
+        self.xram[buf : buf + len(data)] = data
+        return len(data)
+
+    # ---- execution ----------------------------------------------------------
+
+    def run(self, stop):
+        """Execute until stop() is true or the program exits."""
+        table = self.table
+        ram = self.ram
+        flat = self.flat
+        while self.running and not stop():
+            for _ in range(1000):
+                pc = self.pc
+                self.pc = (pc + 1) & 0xFFFF
+                c = table[ram[pc]]()
+                self.cycles += c
+                if flat is not None:
+                    flat[pc] += c
+
+    def call(self, target):
+        name = self.watch.get(target)
+        if name is not None:
+            self.open_calls.append([name, self.cycles, self.s])
+
+    def returned(self):
+        calls = self.open_calls
+        while calls and self.s >= calls[-1][2]:
+            name, start, sp = calls.pop()
+            if sp == self.s and self.on_call_done:
+                # Include the RTS that just completed
+                self.on_call_done(name, start, self.cycles + 6)
+
+
+# ============================================================================
+# 65C02 CORE
+# ============================================================================
+
+
+def build_opcode_table(m: Machine):
+    ram = m.ram
+    rd = m.rd
+    wr = m.wr
+
+    def fetch():
+        v = ram[m.pc]
+        m.pc = (m.pc + 1) & 0xFFFF
+        return v
+
+    def fetch16():
+        pc = m.pc
+        m.pc = (pc + 2) & 0xFFFF
+        return ram[pc] | ram[(pc + 1) & 0xFFFF] << 8
+
+    # ---- addressing modes ---------------------------------------------------
+
+    def imm():
+        pc = m.pc
+        m.pc = (pc + 1) & 0xFFFF
+        return pc
+
+    def zp():
+        return fetch()
+
+    def zpx():
+        return (fetch() + m.x) & 0xFF
+
+    def zpy():
+        return (fetch() + m.y) & 0xFF
+
+    def ab():
+        return fetch16()
+
+    def abx():
+        base = fetch16()
+        a = (base + m.x) & 0xFFFF
+        m.px = 1 if (base ^ a) & 0xFF00 else 0
+        return a
+
+    def aby():
+        base = fetch16()
+        a = (base + m.y) & 0xFFFF
+        m.px = 1 if (base ^ a) & 0xFF00 else 0
+        return a
+
+    def izx():
+        z = (fetch() + m.x) & 0xFF
+        return ram[z] | ram[(z + 1) & 0xFF] << 8
+
+    def izy():
+        z = fetch()
+        base = ram[z] | ram[(z + 1) & 0xFF] << 8
+        a = (base + m.y) & 0xFFFF
+        m.px = 1 if (base ^ a) & 0xFF00 else 0
+        return a
+
+    def izp():
+        z = fetch()
+        return ram[z] | ram[(z + 1) & 0xFF] << 8
+
+    # ---- flags and stack ----------------------------------------------------
+
+    def get_p(brk):
+        return (
+            (0x80 if m.n & 0x80 else 0)
+            | (0x40 if m.v else 0)
+            | 0x20
+            | (0x10 if brk else 0)
+            | (0x08 if m.d else 0)
+            | (0x04 if m.i else 0)
+            | (0x02 if m.z == 0 else 0)
+            | (0x01 if m.c else 0)
+        )
+
+    def set_p(p):
+        m.n = p & 0x80
+        m.v = p & 0x40
+        m.d = p & 0x08
+        m.i = p & 0x04
+        m.z = 0 if p & 0x02 else 1
+        m.c = p & 0x01
+
+    def push(v):
+        ram[0x100 + m.s] = v
+        m.s = (m.s - 1) & 0xFF
+
+    def pull():
+        m.s = (m.s + 1) & 0xFF
+        return ram[0x100 + m.s]
+
+    # ---- ALU ----------------------------------------------------------------
+
+    def adc(v):
+        a = m.a
+        c = 1 if m.c else 0
+        if m.d:
+            lo = (a & 0x0F) + (v & 0x0F) + c
+            if lo > 0x09:
+                lo = ((lo + 0x06) & 0x0F) + 0x10
+            r = (a & 0xF0) + (v & 0xF0) + lo
+            m.v = ~(a ^ v) & (a ^ r) & 0x80
+            if r > 0x9F:
+                r += 0x60
+            m.c = r > 0xFF
+            m.px += 1
+        else:
+            r = a + v + c
+            m.v = ~(a ^ v) & (a ^ r) & 0x80
+            m.c = r > 0xFF
+        m.a = m.n = m.z = r & 0xFF
+
+    def sbc(v):
+        a = m.a
+        c = 1 if m.c else 0
+        r = a - v - 1 + c
+        m.v = (a ^ v) & (a ^ r) & 0x80
+        m.c = r >= 0
+        if m.d:
+            lo = (a & 0x0F) - (v & 0x0F) - 1 + c
+            if r < 0:
+                r -= 0x60
+            if lo < 0:
+                r -= 0x06
+            m.px += 1
+        m.a = m.n = m.z = r & 0xFF
+
+    def cmp(reg, v):
+        r = reg - v
+        m.c = r >= 0
+        m.n = m.z = r & 0xFF
+
+    def ora(v):
+        m.a = m.n = m.z = m.a | v
+
+    def and_(v):
+        m.a = m.n = m.z = m.a & v
+
+    def eor(v):
+        m.a = m.n = m.z = m.a ^ v
+
+    def lda(v):
+        m.a = m.n = m.z = v
+
+    def ldx(v):
+        m.x = m.n = m.z = v
+
+    def ldy(v):
+        m.y = m.n = m.z = v
+
+    def bit(v):
+        m.z = m.a & v
+        m.n = v
+        m.v = v & 0x40
+
+    def bit_imm(v):
+        m.z = m.a & v
+
+    def asl(v):
+        m.c = v & 0x80
+        r = m.n = m.z = (v << 1) & 0xFF
+        return r
+
+    def lsr(v):
+        m.c = v & 0x01
+        r = m.n = m.z = v >> 1
+        return r
+
+    def rol(v):
+        r = m.n = m.z = ((v << 1) | (1 if m.c else 0)) & 0xFF
+        m.c = v & 0x80
+        return r
+
+    def ror(v):
+        r = m.n = m.z = (v >> 1) | (0x80 if m.c else 0)
+        m.c = v & 0x01
+        return r
+
+    def inc(v):
+        r = m.n = m.z = (v + 1) & 0xFF
+        return r
+
+    def dec(v):
+        r = m.n = m.z = (v - 1) & 0xFF
+        return r
+
+    def tsb(v):
+        m.z = m.a & v
+        return v | m.a
+
+    def trb(v):
+        m.z = m.a & v
+        return v & ~m.a & 0xFF
+
+    # ---- handler factories --------------------------------------------------
+
+    def read_op(fn, mode, cycles):
+        def h():
+            m.px = 0
+            fn(rd(mode()))
+            return cycles + m.px
+
+        return h
+
+    def cmp_op(reg, mode, cycles):
+        def h():
+            m.px = 0
+            cmp(getattr(m, reg), rd(mode()))
+            return cycles + m.px
+
+        return h
+
+    def store_op(reg, mode, cycles):
+        def h():
+            wr(mode(), getattr(m, reg))
+            return cycles
+
+        return h
+
+    def stz_op(mode, cycles):
+        def h():
+            wr(mode(), 0)
+            return cycles
+
+        return h
+
+    def rmw_op(fn, mode, cycles, penalty):
+        def h():
+            m.px = 0
+            a = mode()
+            wr(a, fn(rd(a)))
+            return cycles + (m.px if penalty else 0)
+
+        return h
+
+    def acc_op(fn):
+        def h():
+            m.a = fn(m.a)
+            return 2
+
+        return h
+
+    def branch(cond):
+        def h():
+            off = fetch()
+            if not cond():
+                return 2
+            pc = m.pc
+            dest = (pc + off - (0x100 if off & 0x80 else 0)) & 0xFFFF
+            m.pc = dest
+            return 4 if (pc ^ dest) & 0xFF00 else 3
+
+        return h
+
+    def bit_branch(bit, set_):
+        def h():
+            v = ram[fetch()] & (1 << bit)
+            off = fetch()
+            if bool(v) != set_:
+                return 5
+            pc = m.pc
+            dest = (pc + off - (0x100 if off & 0x80 else 0)) & 0xFFFF
+            m.pc = dest
+            return 7 if (pc ^ dest) & 0xFF00 else 6
+
+        return h
+
+    def bit_rmw(bit, set_):
+        mask = 1 << bit
+
+        def h():
+            z = fetch()
+            ram[z] = ram[z] | mask if set_ else ram[z] & ~mask & 0xFF
+            return 5
+
+        return h
+
+    def implied(fn, cycles):
+        def h():
+            fn()
+            return cycles
+
+        return h
+
+    def nop(size, cycles):
+        def h():
+            m.pc = (m.pc + size - 1) & 0xFFFF
+            return cycles
+
+        return h
+
+    # ---- control flow -------------------------------------------------------
+
+    def jsr():
+        target = fetch16()
+        ret = (m.pc - 1) & 0xFFFF
+        m.call(target)
+        push(ret >> 8)
+        push(ret & 0xFF)
+        m.pc = target
+        return 6
+
+    def rts():
+        lo = pull()
+        m.pc = ((pull() << 8 | lo) + 1) & 0xFFFF
+        m.returned()
+        return 6
+
+    def rti():
+        set_p(pull())
+        lo = pull()
+        m.pc = pull() << 8 | lo
+        return 6
+
+    def brk():
+        ret = (m.pc + 1) & 0xFFFF
+        push(ret >> 8)
+        push(ret & 0xFF)
+        push(get_p(True))
+        m.i = 1
+        m.d = 0
+        m.pc = ram[0xFFFE] | ram[0xFFFF] << 8
+        return 7
+
+    def jmp_abs():
+        m.pc = fetch16()
+        return 3
+
+    def jmp_ind():
+        p = fetch16()
+        m.pc = ram[p] | ram[(p + 1) & 0xFFFF] << 8
+        return 6
+
+    def jmp_iax():
+        p = (fetch16() + m.x) & 0xFFFF
+        m.pc = ram[p] | ram[(p + 1) & 0xFFFF] << 8
+        return 6
+
+    def halt(name):
+        def h():
+            raise EmulationError(f"{name} at ${(m.pc - 1) & 0xFFFF:04X}")
+
+        return h
+
+    def setreg(reg, value_fn, flags=True):
+        def h():
+            v = value_fn()
+            setattr(m, reg, v)
+            if flags:
+                m.n = m.z = v
+            return 2
+
+        return h
+
+    def pha():
+        push(m.a)
+
+    def phx():
+        push(m.x)
+
+    def phy():
+        push(m.y)
+
+    def php():
+        push(get_p(True))
+
+    def pla():
+        m.a = m.n = m.z = pull()
+
+    def plx():
+        m.x = m.n = m.z = pull()
+
+    def ply():
+        m.y = m.n = m.z = pull()
+
+    def plp():
+        set_p(pull())
+
+    def flag(name, value):
+        def h():
+            setattr(m, name, value)
+            return 2
+
+        return h
+
+    # ---- opcode map ---------------------------------------------------------
+
+    t = [None] * 256
+    modes = {
+        "imm": imm, "zp": zp, "zpx": zpx, "zpy": zpy, "abs": ab,
+        "abx": abx, "aby": aby, "izx": izx, "izy": izy, "izp": izp,
+    }
+    group1 = [  # ORA AND EOR ADC STA LDA CMP SBC
+        ("ora", ora), ("and", and_), ("eor", eor), ("adc", adc),
+        ("sta", None), ("lda", lda), ("cmp", None), ("sbc", sbc),
+    ]
+    g1_modes = [  # low-nibble offset, mode, read cycles, store cycles
+        (0x09, "imm", 2, None), (0x05, "zp", 3, 3), (0x15, "zpx", 4, 4),
+        (0x0D, "abs", 4, 4), (0x1D, "abx", 4, 5), (0x19, "aby", 4, 5),
+        (0x01, "izx", 6, 6), (0x11, "izy", 5, 6), (0x12, "izp", 5, 5),
+    ]
+    for row, (name, fn) in enumerate(group1):
+        for off, mode, rc, wc in g1_modes:
+            op = row * 0x20 + off
+            if name == "sta":
+                if wc is not None:
+                    t[op] = store_op("a", modes[mode], wc)
+            elif name == "cmp":
+                t[op] = cmp_op("a", modes[mode], rc)
+            else:
+                t[op] = read_op(fn, modes[mode], rc)
+
+    for base, fn in ((0x00, asl), (0x20, rol), (0x40, lsr), (0x60, ror)):
+        t[base + 0x0A] = acc_op(fn)
+        t[base + 0x06] = rmw_op(fn, zp, 5, False)
+        t[base + 0x16] = rmw_op(fn, zpx, 6, False)
+        t[base + 0x0E] = rmw_op(fn, ab, 6, False)
+        t[base + 0x1E] = rmw_op(fn, abx, 6, True)
+    for base, fn, acc in ((0xC0, dec, 0x3A), (0xE0, inc, 0x1A)):
+        t[acc] = acc_op(fn)
+        t[base + 0x06] = rmw_op(fn, zp, 5, False)
+        t[base + 0x16] = rmw_op(fn, zpx, 6, False)
+        t[base + 0x0E] = rmw_op(fn, ab, 6, False)
+        t[base + 0x1E] = rmw_op(fn, abx, 7, False)
+    t[0x04] = rmw_op(tsb, zp, 5, False)
+    t[0x0C] = rmw_op(tsb, ab, 6, False)
+    t[0x14] = rmw_op(trb, zp, 5, False)
+    t[0x1C] = rmw_op(trb, ab, 6, False)
+
+    t[0x89] = read_op(bit_imm, imm, 2)
+    t[0x24] = read_op(bit, zp, 3)
+    t[0x34] = read_op(bit, zpx, 4)
+    t[0x2C] = read_op(bit, ab, 4)
+    t[0x3C] = read_op(bit, abx, 4)
+
+    t[0xA2] = read_op(ldx, imm, 2)
+    t[0xA6] = read_op(ldx, zp, 3)
+    t[0xB6] = read_op(ldx, zpy, 4)
+    t[0xAE] = read_op(ldx, ab, 4)
+    t[0xBE] = read_op(ldx, aby, 4)
+    t[0xA0] = read_op(ldy, imm, 2)
+    t[0xA4] = read_op(ldy, zp, 3)
+    t[0xB4] = read_op(ldy, zpx, 4)
+    t[0xAC] = read_op(ldy, ab, 4)
+    t[0xBC] = read_op(ldy, abx, 4)
+    t[0x86] = store_op("x", zp, 3)
+    t[0x96] = store_op("x", zpy, 4)
+    t[0x8E] = store_op("x", ab, 4)
+    t[0x84] = store_op("y", zp, 3)
+    t[0x94] = store_op("y", zpx, 4)
+    t[0x8C] = store_op("y", ab, 4)
+    t[0x64] = stz_op(zp, 3)
+    t[0x74] = stz_op(zpx, 4)
+    t[0x9C] = stz_op(ab, 4)
+    t[0x9E] = stz_op(abx, 5)
+    t[0xE0] = cmp_op("x", imm, 2)
+    t[0xE4] = cmp_op("x", zp, 3)
+    t[0xEC] = cmp_op("x", ab, 4)
+    t[0xC0] = cmp_op("y", imm, 2)
+    t[0xC4] = cmp_op("y", zp, 3)
+    t[0xCC] = cmp_op("y", ab, 4)
+
+    t[0x10] = branch(lambda: not m.n & 0x80)
+    t[0x30] = branch(lambda: m.n & 0x80)
+    t[0x50] = branch(lambda: not m.v)
+    t[0x70] = branch(lambda: m.v)
+    t[0x80] = branch(lambda: True)
+    t[0x90] = branch(lambda: not m.c)
+    t[0xB0] = branch(lambda: m.c)
+    t[0xD0] = branch(lambda: m.z != 0)
+    t[0xF0] = branch(lambda: m.z == 0)
+    for bit_ in range(8):
+        t[0x0F + bit_ * 0x10] = bit_branch(bit_, False)
+        t[0x8F + bit_ * 0x10] = bit_branch(bit_, True)
+        t[0x07 + bit_ * 0x10] = bit_rmw(bit_, False)
+        t[0x87 + bit_ * 0x10] = bit_rmw(bit_, True)
+
+    t[0x00] = brk
+    t[0x20] = jsr
+    t[0x40] = rti
+    t[0x60] = rts
+    t[0x4C] = jmp_abs
+    t[0x6C] = jmp_ind
+    t[0x7C] = jmp_iax
+    t[0xCB] = halt("WAI")
+    t[0xDB] = halt("STP")
+
+    t[0x48] = implied(pha, 3)
+    t[0xDA] = implied(phx, 3)
+    t[0x5A] = implied(phy, 3)
+    t[0x08] = implied(php, 3)
+    t[0x68] = implied(pla, 4)
+    t[0xFA] = implied(plx, 4)
+    t[0x7A] = implied(ply, 4)
+    t[0x28] = implied(plp, 4)
+
+    t[0x18] = flag("c", 0)
+    t[0x38] = flag("c", 1)
+    t[0x58] = flag("i", 0)
+    t[0x78] = flag("i", 1)
+    t[0xB8] = flag("v", 0)
+    t[0xD8] = flag("d", 0)
+    t[0xF8] = flag("d", 1)
+
+    t[0xAA] = setreg("x", lambda: m.a)
+    t[0xA8] = setreg("y", lambda: m.a)
+    t[0x8A] = setreg("a", lambda: m.x)
+    t[0x98] = setreg("a", lambda: m.y)
+    t[0xBA] = setreg("x", lambda: m.s)
+    t[0x9A] = setreg("s", lambda: m.x, flags=False)
+    t[0xE8] = setreg("x", lambda: (m.x + 1) & 0xFF)
+    t[0xC8] = setreg("y", lambda: (m.y + 1) & 0xFF)
+    t[0xCA] = setreg("x", lambda: (m.x - 1) & 0xFF)
+    t[0x88] = setreg("y", lambda: (m.y - 1) & 0xFF)
+
+    # Every remaining opcode is a NOP on the 65C02
+    t[0xEA] = nop(1, 2)
+    for op in (0x02, 0x22, 0x42, 0x62, 0x82, 0xC2, 0xE2):
+        t[op] = nop(2, 2)
+    t[0x44] = nop(2, 3)
+    for op in (0x54, 0xD4, 0xF4):
+        t[op] = nop(2, 4)
+    t[0x5C] = nop(3, 8)
+    for op in (0xDC, 0xFC):
+        t[op] = nop(3, 4)
+    for op in range(256):
+        if t[op] is None:
+            t[op] = nop(1, 1)
+    return t
+
+
+# ============================================================================
+# PROFILER
+# ============================================================================
+
+
+class Profiler:
+    """Accumulates inclusive cycles per watched function per frame."""
+
+    def __init__(self, m: Machine, names):
+        self.m = m
+        self.names = names
+        self.frames = {}  # frame index -> {name: cycles}
+        self.calls = {name: 0 for name in names}
+        m.on_call_done = self.call_done
+
+    def call_done(self, name, start, end):
+        frame = start // self.m.cycles_per_frame
+        row = self.frames.setdefault(frame, {})
+        row[name] = row.get(name, 0) + end - start
+        self.calls[name] += 1
+
+    def report(self, out):
+        budget = self.m.cycles_per_frame
+        frames = sorted(self.frames)
+        if not frames:
+            print("No profiled calls were made.", file=out)
+            return
+        count = len(frames)
+        print(
+            f"{count} frames sampled, budget {budget} cycles/frame "
+            f"({self.m.phi2_khz} kHz, 60 Hz)",
+            file=out,
+        )
+        print(
+            f"{'function':<20} {'calls/fr':>8} {'avg cyc':>9} {'max cyc':>9}"
+            f" {'avg %':>7} {'max %':>7}",
+            file=out,
+        )
+        idle = self.m.idle
+        busy = [budget - idle.get(f, 0) for f in frames]
+        rows = [("(frame busy)", busy, 1.0)]
+        for name in self.names:
+            samples = [self.frames[f].get(name, 0) for f in frames]
+            rows.append((name, samples, self.calls[name] / count))
+        for name, samples, per_frame in rows:
+            avg = sum(samples) / count
+            peak = max(samples)
+            print(
+                f"{name:<20} {per_frame:>8.2f} {avg:>9.0f}"
+                f" {peak:>9} {100 * avg / budget:>6.1f}% {100 * peak / budget:>6.1f}%",
+                file=out,
+            )
+        overruns = sum(1 for f in frames if f not in idle)
+        print(f"{overruns} of {count} frames had no idle time (vsync missed)", file=out)
+
+
+def flat_report(m: Machine, functions: dict, top: int, out):
+    """Self cycles per function from the per-PC counters."""
+    starts = sorted((addr, name) for name, addr in functions.items())
+    keys = [addr for addr, _ in starts]
+    totals = {}
+    for pc, c in enumerate(m.flat):
+        if c:
+            i = bisect.bisect_right(keys, pc) - 1
+            name = starts[i][1] if i >= 0 else f"${pc:04X}"
+            totals[name] = totals.get(name, 0) + c
+    total = sum(totals.values()) or 1
+    print(f"\nSelf cycles, top {top} functions:", file=out)
+    for name, c in sorted(totals.items(), key=lambda kv: -kv[1])[:top]:
+        print(f"{name:<32} {c:>12} {100 * c / total:>6.1f}%", file=out)
+
+
+def exec_args():
+    parser = argparse.ArgumentParser(
+        description="Profile CPU cycles per frame of an RP6502 ROM."
+    )
+    parser.add_argument("rom", help="RP6502 ROM file (.rp6502).")
+    parser.add_argument(
+        "--elf", help="llvm-mos ELF with symbols. Default: ROM name with .elf."
+    )
+    parser.add_argument(
+        "--frames", type=int, default=1800, help="Frames to run. Default: 1800."
+    )
+    parser.add_argument(
+        "--phi2", type=int, default=8000, help="CPU clock in kHz. Default: 8000."
+    )
+    parser.add_argument(
+        "--func",
+        action="append",
+        default=[],
+        help="Profile this function too. May be repeated.",
+    )
+    parser.add_argument(
+        "--start",
+        type=int,
+        default=60,
+        help="Press ENTER at this frame to leave the title screen. Default: 60.",
+    )
+    parser.add_argument(
+        "--fire", action="store_true", help="Hold SPACE during gameplay."
+    )
+    parser.add_argument(
+        "--keyboard",
+        type=lambda s: int(s, 0),
+        default=KEYBOARD_INPUT,
+        help=f"XRAM address of the keyboard bitmap. Default: 0x{KEYBOARD_INPUT:04X}.",
+    )
+    parser.add_argument(
+        "--root", default=".", help="Directory that stands in for the USB drive."
+    )
+    parser.add_argument(
+        "--flat", type=int, metavar="N", help="Also list the top N self-cycle functions."
+    )
+    parser.add_argument(
+        "--echo", action="store_true", help="Copy the program's console output."
+    )
+    args = parser.parse_args()
+
+    elf = args.elf or re.sub(r"\.rp6502$", "", args.rom) + ".elf"
+    functions = load_elf_functions(elf)
+    names = [n for n in DEFAULT_FUNCTIONS + args.func if n in functions]
+    for n in DEFAULT_FUNCTIONS + args.func:
+        if n not in functions:
+            print(
+                f"profile6502: {n} not in {elf} (inlined? build with ENABLE_PROFILE)",
+                file=sys.stderr,
+            )
+
+    m = Machine(args.phi2, args.root, args.echo)
+    load_rp6502_rom(args.rom, m.ram, m.xram)
+    m.reset()
+    m.watch = {functions[n]: n for n in names}
+    if args.flat:
+        m.flat = [0] * 0x10000
+    profiler = Profiler(m, names)
+
+    enter = (args.keyboard + (KEY_ENTER >> 3), 1 << (KEY_ENTER & 7))
+    space = (args.keyboard + (KEY_SPACE >> 3), 1 << (KEY_SPACE & 7))
+
+    def on_frame():
+        # Tap ENTER for ten frames, then optionally hold SPACE
+        frame = m.next_vsync // m.cycles_per_frame - 1
+        held = args.start <= frame < args.start + 10
+        m.xram[enter[0]] = m.xram[enter[0]] | enter[1] if held else m.xram[enter[0]] & ~enter[1]
+        if args.fire and frame >= args.start + 20:
+            m.xram[space[0]] |= space[1]
+
+    m.frame_hook = on_frame
+    limit = args.frames * m.cycles_per_frame
+    try:
+        m.run(lambda: m.cycles >= limit)
+    except EmulationError as e:
+        print(f"profile6502: {e}", file=sys.stderr)
+    if m.exit_code is not None:
+        print(f"profile6502: program exited with {m.exit_code}", file=sys.stderr)
+
+    profiler.report(sys.stdout)
+    if args.flat:
+        flat_report(m, functions, args.flat, sys.stdout)
+
+
+if __name__ == "__main__":
+    exec_args()